@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "api/api_chat_participants.h"
 
+#include "api/api_hash.h"
 #include "apiwrap.h"
 #include "boxes/add_contact_box.h" // ShowAddParticipantsError
 #include "data/data_changes.h"
@@ -370,7 +371,12 @@ void ChatParticipants::requestLast(not_null<ChannelData*> channel) {
 	}
 
 	const auto offset = 0;
-	const auto participantsHash = uint64(0);
+	const auto i = _lastParticipantsHashes.find(channel);
+	const auto participantsHash = (i != end(_lastParticipantsHashes)
+		&& (channel->mgInfo->lastParticipantsStatus
+			& MegagroupInfo::LastParticipantsOnceReceived))
+		? i->second
+		: uint64(0);
 	const auto requestId = _api.request(MTPchannels_GetParticipants(
 		channel->inputChannel,
 		MTP_channelParticipantsRecent(),
@@ -382,10 +388,25 @@ void ChatParticipants::requestLast(not_null<ChannelData*> channel) {
 
 		result.match([&](const MTPDchannels_channelParticipants &data) {
 			const auto &[availableCount, list] = Parse(channel, data);
+			auto hash = HashInit();
+			for (const auto &participant : list) {
+				HashUpdate(hash, participant.id().value);
+			}
+			_lastParticipantsHashes[channel] = HashFinalize(hash);
 			ApplyLastList(channel, availableCount, list);
-		}, [](const MTPDchannels_channelParticipantsNotModified &) {
-			LOG(("API Error: "
-				"channels.channelParticipantsNotModified received!"));
+		}, [&](const MTPDchannels_channelParticipantsNotModified &) {
+			if (!participantsHash) {
+				LOG(("API Error: "
+					"channels.channelParticipantsNotModified received!"));
+				return;
+			}
+			// The list we already have is still actual.
+			channel->mgInfo->lastParticipantsStatus
+				= MegagroupInfo::LastParticipantsUpToDate
+				| MegagroupInfo::LastParticipantsOnceReceived;
+			channel->session().changes().peerUpdated(
+				channel,
+				Data::PeerUpdate::Flag::Members);
 		});
 	}).fail([this, channel] {
 		_participantsRequests.remove(channel);
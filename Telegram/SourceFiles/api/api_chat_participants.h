@@ -122,6 +122,7 @@ private:
 	PeerRequests _participantsRequests;
 	PeerRequests _botsRequests;
 	PeerRequests _adminsRequests;
+	base::flat_map<not_null<ChannelData*>, uint64> _lastParticipantsHashes;
 	base::DelayedCallTimer _participantsCountRequestTimer;
 
 	struct {
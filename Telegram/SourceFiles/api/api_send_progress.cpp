@@ -22,6 +22,7 @@ constexpr auto kCancelTypingActionTimeout = crl::time(5000);
 constexpr auto kSendMySpeakingInterval = 3 * crl::time(1000);
 constexpr auto kSendMyTypingInterval = 5 * crl::time(1000);
 constexpr auto kSendTypingsToOfflineFor = TimeId(30);
+constexpr auto kSendProgressDelay = crl::time(50);
 
 } // namespace
 
@@ -142,7 +143,7 @@ void SendProgressManager::send(const Key &key, int progress) {
 		action
 	)).done([=](const MTPBool &result, mtpRequestId requestId) {
 		done(result, requestId);
-	}).send();
+	}).afterDelay(kSendProgressDelay).send();
 	_requests.emplace(key, requestId);
 
 	if (key.type == Type::Typing) {
@@ -41,6 +41,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item.h"
 #include "history/history_unread_things.h"
 #include "core/application.h"
+#include "core/metrics.h"
 #include "storage/storage_account.h"
 #include "storage/storage_facade.h"
 #include "storage/storage_user_photos.h"
@@ -580,12 +581,23 @@ void Updates::feedDifference(
 		const MTPVector<MTPChat> &chats,
 		const MTPVector<MTPMessage> &msgs,
 		const MTPVector<MTPUpdate> &other) {
+	static auto &Differences = Core::Metrics::Counter("difference.count");
+	static auto &Messages = Core::Metrics::Counter("difference.messages");
+	static auto &Other = Core::Metrics::Counter("difference.updates");
+	static auto &Time = Core::Metrics::Counter("difference.ms");
+
+	const auto started = crl::now();
 	Core::App().checkAutoLock();
 	session().data().processUsers(users);
 	session().data().processChats(chats);
 	feedMessageIds(other);
 	session().data().processMessages(msgs, NewMessageType::Unread);
 	feedUpdateVector(other, SkipUpdatePolicy::SkipMessageIds);
+
+	++Differences;
+	Messages += msgs.v.size();
+	Other += other.v.size();
+	Time += crl::now() - started;
 }
 
 void Updates::differenceFail(const MTP::Error &error) {
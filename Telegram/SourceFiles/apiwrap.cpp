@@ -100,8 +100,10 @@ constexpr auto kTopPromotionInterval = TimeId(60 * 60);
 constexpr auto kTopPromotionMinDelay = TimeId(10);
 constexpr auto kSmallDelayMs = 5;
 constexpr auto kSharedMediaLimit = 100;
+constexpr auto kPeersPerRequest = 100;
 constexpr auto kReadFeaturedSetsTimeout = crl::time(1000);
 constexpr auto kFileLoaderQueueStopTimeout = crl::time(5000);
+constexpr auto kFileLoaderQueueThreads = 0; // One for each core.
 constexpr auto kStickersByEmojiInvalidateTimeout = crl::time(6 * 1000);
 constexpr auto kNotifySettingSaveTimeout = crl::time(1000);
 constexpr auto kDialogsFirstLoad = 20;
@@ -121,11 +123,14 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 : MTP::Sender(&session->account().mtp())
 , _session(session)
 , _messageDataResolveDelayed([=] { resolveMessageDatas(); })
+, _peersResolveDelayed([=] { resolvePeers(); })
 , _webPagesTimer([=] { resolveWebPages(); })
 , _draftsSaveTimer([=] { saveDraftsToCloud(); })
 , _featuredSetsReadTimer([=] { readFeaturedSets(); })
 , _dialogsLoadState(std::make_unique<DialogsLoadState>())
-, _fileLoader(std::make_unique<TaskQueue>(kFileLoaderQueueStopTimeout))
+, _fileLoader(std::make_unique<TaskQueue>(
+	kFileLoaderQueueStopTimeout,
+	kFileLoaderQueueThreads))
 , _topPromotionTimer([=] { refreshTopPromotion(); })
 , _updateNotifySettingsTimer([=] { sendNotifySettingsUpdates(); })
 , _authorizations(std::make_unique<Api::Authorizations>(this))
@@ -998,7 +1003,7 @@ void ApiWrap::requestFullPeer(not_null<PeerData*> peer) {
 					_session->data().processChats(data.vchats());
 				});
 				gotUserFull(user, result, requestId);
-			}).fail(failHandler).send();
+			}).fail(failHandler).shareIdentical().send();
 		} else if (const auto chat = peer->asChat()) {
 			return request(MTPmessages_GetFullChat(
 				chat->inputChat
@@ -1097,37 +1102,141 @@ void ApiWrap::requestPeer(not_null<PeerData*> peer) {
 		return;
 	}
 
-	const auto requestId = [&] {
-		const auto failHandler = [=] {
-			_peerRequests.remove(peer);
-		};
-		const auto chatHandler = [=](const MTPmessages_Chats &result) {
-			_peerRequests.remove(peer);
-			const auto &chats = result.match([](const auto &data) {
-				return data.vchats();
-			});
-			_session->data().applyMaximumChatVersions(chats);
-			_session->data().processChats(chats);
+	// Peers are often requested one by one, for example for replies
+	// from unknown users, so we send them together a bit later.
+	_peerRequests.insert(peer, 0);
+	_peersResolveDelayed.call();
+}
+
+void ApiWrap::resolvePeers() {
+	auto users = QVector<MTPInputUser>();
+	auto chats = QVector<MTPlong>();
+	auto channels = QVector<MTPInputChannel>();
+	auto usersPending = std::vector<not_null<PeerData*>>();
+	auto chatsPending = std::vector<not_null<PeerData*>>();
+	auto channelsPending = std::vector<not_null<PeerData*>>();
+	auto alone = std::vector<not_null<PeerData*>>();
+	auto more = false;
+	for (auto i = _peerRequests.begin(); i != _peerRequests.end(); ++i) {
+		if (i.value()) {
+			continue;
+		}
+		const auto peer = not_null{ i.key() };
+		if (_peersResolveAlone.contains(peer)) {
+			alone.push_back(peer);
+			continue;
+		}
+		const auto add = [&](auto &list, auto &pending, auto input) {
+			if (list.size() < kPeersPerRequest) {
+				list.push_back(input);
+				pending.push_back(peer);
+			} else {
+				more = true;
+			}
 		};
 		if (const auto user = peer->asUser()) {
-			return request(MTPusers_GetUsers(
-				MTP_vector<MTPInputUser>(1, user->inputUser)
-			)).done([=](const MTPVector<MTPUser> &result) {
-				_peerRequests.remove(user);
-				_session->data().processUsers(result);
-			}).fail(failHandler).send();
+			add(users, usersPending, user->inputUser);
 		} else if (const auto chat = peer->asChat()) {
-			return request(MTPmessages_GetChats(
-				MTP_vector<MTPlong>(1, chat->inputChat)
-			)).done(chatHandler).fail(failHandler).send();
+			add(chats, chatsPending, chat->inputChat);
 		} else if (const auto channel = peer->asChannel()) {
-			return request(MTPchannels_GetChannels(
-				MTP_vector<MTPInputChannel>(1, channel->inputChannel)
-			)).done(chatHandler).fail(failHandler).send();
+			add(channels, channelsPending, channel->inputChannel);
 		}
-		Unexpected("Peer type in requestPeer.");
-	}();
-	_peerRequests.insert(peer, requestId);
+	}
+	const auto finish = [=](mtpRequestId requestId) {
+		for (auto i = _peerRequests.begin(); i != _peerRequests.end();) {
+			if (i.value() == requestId) {
+				_peersResolveAlone.remove(i.key());
+				i = _peerRequests.erase(i);
+			} else {
+				++i;
+			}
+		}
+	};
+	const auto chatsDone = [=](
+			const MTPmessages_Chats &result,
+			mtpRequestId requestId) {
+		finish(requestId);
+		const auto &chats = result.match([](const auto &data) {
+			return data.vchats();
+		});
+		_session->data().applyMaximumChatVersions(chats);
+		_session->data().processChats(chats);
+	};
+	const auto fail = [=](const MTP::Error &error, mtpRequestId requestId) {
+		auto batch = std::vector<not_null<PeerData*>>();
+		for (auto i = _peerRequests.begin(); i != _peerRequests.end(); ++i) {
+			if (i.value() == requestId) {
+				batch.push_back(i.key());
+			}
+		}
+		if (batch.size() < 2) {
+			finish(requestId);
+			return;
+		}
+		// One bad peer fails the whole batch, so retry them one by one.
+		for (const auto &peer : batch) {
+			_peerRequests[peer] = 0;
+			_peersResolveAlone.emplace(peer);
+		}
+		_peersResolveDelayed.call();
+	};
+	const auto assign = [&](
+			const std::vector<not_null<PeerData*>> &pending,
+			mtpRequestId requestId) {
+		for (const auto &peer : pending) {
+			_peerRequests[peer] = requestId;
+		}
+	};
+	const auto sendUsers = [&](
+			const QVector<MTPInputUser> &users,
+			const std::vector<not_null<PeerData*>> &pending) {
+		assign(pending, request(MTPusers_GetUsers(
+			MTP_vector<MTPInputUser>(users)
+		)).done([=](
+				const MTPVector<MTPUser> &result,
+				mtpRequestId requestId) {
+			finish(requestId);
+			_session->data().processUsers(result);
+		}).fail(fail).afterDelay(kSmallDelayMs).send());
+	};
+	const auto sendChats = [&](
+			const QVector<MTPlong> &chats,
+			const std::vector<not_null<PeerData*>> &pending) {
+		assign(pending, request(MTPmessages_GetChats(
+			MTP_vector<MTPlong>(chats)
+		)).done(chatsDone).fail(fail).afterDelay(kSmallDelayMs).send());
+	};
+	const auto sendChannels = [&](
+			const QVector<MTPInputChannel> &channels,
+			const std::vector<not_null<PeerData*>> &pending) {
+		assign(pending, request(MTPchannels_GetChannels(
+			MTP_vector<MTPInputChannel>(channels)
+		)).done(chatsDone).fail(fail).afterDelay(kSmallDelayMs).send());
+	};
+	if (!users.isEmpty()) {
+		sendUsers(users, usersPending);
+	}
+	if (!chats.isEmpty()) {
+		sendChats(chats, chatsPending);
+	}
+	if (!channels.isEmpty()) {
+		sendChannels(channels, channelsPending);
+	}
+	for (const auto &peer : alone) {
+		const auto pending = std::vector<not_null<PeerData*>>{ peer };
+		if (const auto user = peer->asUser()) {
+			sendUsers(QVector<MTPInputUser>(1, user->inputUser), pending);
+		} else if (const auto chat = peer->asChat()) {
+			sendChats(QVector<MTPlong>(1, chat->inputChat), pending);
+		} else if (const auto channel = peer->asChannel()) {
+			sendChannels(
+				QVector<MTPInputChannel>(1, channel->inputChannel),
+				pending);
+		}
+	}
+	if (more) {
+		_peersResolveDelayed.call();
+	}
 }
 
 void ApiWrap::requestPeerSettings(not_null<PeerData*> peer) {
@@ -1257,13 +1366,13 @@ void ApiWrap::markContentsRead(
 			MTP_vector<MTPint>(markedIds)
 		)).done([=](const MTPmessages_AffectedMessages &result) {
 			applyAffectedMessages(result);
-		}).send();
+		}).afterDelay(kSmallDelayMs).send();
 	}
 	for (const auto &channelIds : channelMarkedIds) {
 		request(MTPchannels_ReadMessageContents(
 			channelIds.first->inputChannel,
 			MTP_vector<MTPint>(channelIds.second)
-		)).send();
+		)).afterDelay(kSmallDelayMs).send();
 	}
 }
 
@@ -1276,13 +1385,13 @@ void ApiWrap::markContentsRead(not_null<HistoryItem*> item) {
 		request(MTPchannels_ReadMessageContents(
 			channel->inputChannel,
 			ids
-		)).send();
+		)).afterDelay(kSmallDelayMs).send();
 	} else {
 		request(MTPmessages_ReadMessageContents(
 			ids
 		)).done([=](const MTPmessages_AffectedMessages &result) {
 			applyAffectedMessages(result);
-		}).send();
+		}).afterDelay(kSmallDelayMs).send();
 	}
 }
 
@@ -408,6 +408,7 @@ private:
 	void saveDraftsToCloud();
 
 	void resolveMessageDatas();
+	void resolvePeers();
 	void finalizeMessageDataRequest(
 		ChannelData *channel,
 		mtpRequestId requestId);
@@ -530,6 +531,8 @@ private:
 	using PeerRequests = QMap<PeerData*, mtpRequestId>;
 	PeerRequests _fullPeerRequests;
 	PeerRequests _peerRequests;
+	base::flat_set<not_null<PeerData*>> _peersResolveAlone;
+	SingleQueuedInvokation _peersResolveDelayed;
 	base::flat_set<not_null<PeerData*>> _requestedPeerSettings;
 
 	base::flat_map<
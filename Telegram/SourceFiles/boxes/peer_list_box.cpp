@@ -1772,12 +1772,12 @@ void PeerListContent::searchQueryChanged(QString query) {
 				auto searchWordInNames = [](
 						not_null<PeerData*> peer,
 						const QString &searchWord) {
-					for (auto &nameWord : peer->nameWords()) {
-						if (nameWord.startsWith(searchWord)) {
-							return true;
-						}
-					}
-					return false;
+					// All name words starting with 'searchWord'
+					// follow it in the sorted set.
+					const auto &nameWords = peer->nameWords();
+					const auto i = nameWords.lower_bound(searchWord);
+					return (i != nameWords.end())
+						&& i->startsWith(searchWord);
 				};
 				auto allSearchWordsInNames = [&](
 						not_null<PeerData*> peer) {
@@ -541,7 +541,7 @@ bool AddSpecialBoxController::checkInfoLoaded(
 	}).fail([=] {
 		_additional.setExternal(participant);
 		callback();
-	}).send();
+	}).shareIdentical().send();
 	return false;
 }
 
@@ -2108,6 +2108,7 @@ void StickersBox::Inner::rebuild(bool masks) {
 		}
 
 		const auto set = it->second.get();
+		set->materializeLocalStickers();
 		rebuildAppendSet(set, maxNameWidth);
 
 		if (set->stickers.isEmpty()
@@ -141,12 +141,24 @@ void VideoBubble::prepareFrame() {
 	const auto original = _track->frameSize();
 	if (original.isEmpty()) {
 		_frame = QImage();
+		_preparedFrameIndex = -1;
 		return;
 	}
 	const auto padding = st::boxRoundShadow.extend;
 	const auto size = _content.rect().marginsRemoved(padding).size()
 		* cIntRetinaFactor();
 
+	// The bubble is repainted together with the incoming video, so most
+	// paints happen without a new outgoing frame, reuse the rounded one.
+	const auto index = _track->frameWithInfo(false).index;
+	if (!_frame.isNull()
+		&& _preparedFrameIndex == index
+		&& _preparedSize == size) {
+		return;
+	}
+	_preparedFrameIndex = index;
+	_preparedSize = size;
+
 	// Should we check 'original' and 'size' aspect ratios?..
 	const auto request = Webrtc::FrameRequest{
 		.resize = size,
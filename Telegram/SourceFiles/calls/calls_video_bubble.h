@@ -54,6 +54,8 @@ private:
 	Webrtc::VideoState _state = Webrtc::VideoState();
 	QImage _frame, _pausedFrame;
 	QSize _min, _max, _size, _lastDraggableSize, _lastFrameSize;
+	QSize _preparedSize;
+	int _preparedFrameIndex = -1;
 	QRect _boundingRect;
 	DragMode _dragMode = DragMode::None;
 	RectPart _corner = RectPart::None;
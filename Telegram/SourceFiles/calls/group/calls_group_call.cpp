@@ -52,6 +52,52 @@ constexpr auto kFixSpeakingLargeVideoDuration = 3 * crl::time(1000);
 constexpr auto kFullAsMediumsCount = 4; // 1 Full is like 4 Mediums.
 constexpr auto kMaxMediumQualities = 16; // 4 Fulls or 16 Mediums.
 
+// Levels come from the audio thread, while the main thread is busy they
+// are merged per ssrc, so that only one main thread call is queued.
+class PendingLevels final {
+public:
+	// Returns true if the main thread should be notified.
+	[[nodiscard]] bool push(const tgcalls::GroupLevelsUpdate &data);
+	[[nodiscard]] tgcalls::GroupLevelsUpdate take();
+
+private:
+	QMutex _mutex;
+	tgcalls::GroupLevelsUpdate _data;
+	bool _scheduled = false;
+
+};
+
+bool PendingLevels::push(const tgcalls::GroupLevelsUpdate &data) {
+	QMutexLocker lock(&_mutex);
+	if (!_scheduled) {
+		_data = data;
+		_scheduled = true;
+		return true;
+	}
+	for (const auto &update : data.updates) {
+		const auto i = ranges::find_if(_data.updates, [&](const auto &was) {
+			return (was.ssrc == update.ssrc);
+		});
+		if (i == end(_data.updates)) {
+			_data.updates.push_back(update);
+		} else {
+			// Keep the loudest value, so that no speaking is missed.
+			const auto voice = i->value.voice || update.value.voice;
+			if (update.value.level > i->value.level) {
+				i->value = update.value;
+			}
+			i->value.voice = voice;
+		}
+	}
+	return false;
+}
+
+tgcalls::GroupLevelsUpdate PendingLevels::take() {
+	QMutexLocker lock(&_mutex);
+	_scheduled = false;
+	return base::take(_data);
+}
+
 [[nodiscard]] std::unique_ptr<Webrtc::MediaDevices> CreateMediaDevices() {
 	const auto &settings = Core::App().settings();
 	return Webrtc::CreateMediaDevices(
@@ -2340,6 +2386,7 @@ bool GroupCall::tryCreateController() {
 
 	const auto weak = base::make_weak(&_instanceGuard);
 	const auto myLevel = std::make_shared<tgcalls::GroupLevelValue>();
+	const auto pendingLevels = std::make_shared<PendingLevels>();
 	tgcalls::GroupInstanceDescriptor descriptor = {
 		.threads = tgcalls::StaticThreads::getThreads(),
 		.config = tgcalls::GroupConfig{
@@ -2360,7 +2407,14 @@ bool GroupCall::tryCreateController() {
 				}
 				*myLevel = updates.front().value;
 			}
-			crl::on_main(weak, [=] { audioLevelsUpdated(data); });
+			if (pendingLevels->push(data)) {
+				crl::on_main(weak, [=] {
+					const auto levels = pendingLevels->take();
+					if (!levels.updates.empty()) {
+						audioLevelsUpdated(levels);
+					}
+				});
+			}
 		},
 		.initialInputDeviceId = _audioInputId.toStdString(),
 		.initialOutputDeviceId = _audioOutputId.toStdString(),
@@ -31,6 +31,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Calls::Group {
 namespace {
 
+// A tile keeps its quality until it is this much below the threshold.
+constexpr auto kQualityDowngradePercent = 90;
+
 [[nodiscard]] QRect InterpolateRect(QRect a, QRect b, float64 ratio) {
 	const auto left = anim::interpolate(a.x(), b.x(), ratio);
 	const auto top = anim::interpolate(a.y(), b.y(), ratio);
@@ -776,11 +779,18 @@ void Viewport::setTileGeometry(not_null<VideoTile*> tile, QRect geometry) {
 	const auto forceThumbnailQuality = !wide()
 		&& (ranges::count(_tiles, false, &VideoTile::hidden) > 1);
 	const auto forceFullQuality = wide() && (tile.get() == _large);
+	const auto current = tile->requestedQuality();
+	const auto keep = [&](VideoQuality quality, int threshold) {
+		return (current == quality)
+			&& (min * 100 >= threshold * kQualityDowngradePercent);
+	};
 	const auto quality = forceThumbnailQuality
 		? VideoQuality::Thumbnail
-		: (forceFullQuality || min >= kMedium)
+		: (forceFullQuality
+			|| min >= kMedium
+			|| keep(VideoQuality::Full, kMedium))
 		? VideoQuality::Full
-		: (min >= kSmall)
+		: (min >= kSmall || keep(VideoQuality::Medium, kSmall))
 		? VideoQuality::Medium
 		: VideoQuality::Thumbnail;
 	if (tile->updateRequestedQuality(quality)) {
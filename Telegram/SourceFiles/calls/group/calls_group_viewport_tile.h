@@ -77,6 +77,9 @@ public:
 	void hide();
 	void toggleTopControlsShown(bool shown);
 	bool updateRequestedQuality(VideoQuality quality);
+	[[nodiscard]] std::optional<VideoQuality> requestedQuality() const {
+		return _quality;
+	}
 
 	[[nodiscard]] rpl::lifetime &lifetime() {
 		return _lifetime;
@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "apiwrap.h"
 
 #include <QtGui/QGuiApplication>
+#include <unordered_set>
 
 namespace ChatHelpers {
 namespace {
@@ -172,26 +173,21 @@ void WriteLocalCache(const QString &id, const LangPackData &data) {
 
 void AppendFoundEmoji(
 		std::vector<Result> &result,
+		std::unordered_set<EmojiPtr> &added,
 		const QString &label,
 		const std::vector<LangPackEmoji> &list) {
-	// It is important that the 'result' won't relocate while inserting.
+	// Entries of the 'list' have no duplicates between themselves,
+	// so check only against the emoji added before it.
+	const auto already = int(result.size());
 	result.reserve(result.size() + list.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
-	auto &&add = ranges::views::all(
-		list
-	) | ranges::views::filter([&](const LangPackEmoji &entry) {
-		const auto i = ranges::find(
-			alreadyBegin,
-			alreadyEnd,
-			entry.emoji,
-			&Result::emoji);
-		return (i == alreadyEnd);
-	}) | ranges::views::transform([&](const LangPackEmoji &entry) {
-		return Result{ entry.emoji, label, entry.text };
-	});
-	result.insert(end(result), add.begin(), add.end());
+	for (const auto &entry : list) {
+		if (!added.contains(entry.emoji)) {
+			result.push_back({ entry.emoji, label, entry.text });
+		}
+	}
+	for (auto i = already, count = int(result.size()); i != count; ++i) {
+		added.emplace(result[i].emoji);
+	}
 }
 
 void AppendLegacySuggestions(
@@ -486,8 +482,9 @@ std::vector<Result> EmojiKeywords::LangPack::query(
 	});
 
 	auto result = std::vector<Result>();
+	auto added = std::unordered_set<EmojiPtr>();
 	for (const auto &[key, list] : chosen) {
-		AppendFoundEmoji(result, key, list);
+		AppendFoundEmoji(result, added, key, list);
 	}
 	return result;
 }
@@ -610,27 +607,22 @@ std::vector<Result> EmojiKeywords::query(
 		return {};
 	}
 	auto result = std::vector<Result>();
+	auto added = std::unordered_set<EmojiPtr>();
 	for (const auto &[language, item] : _data) {
 		const auto list = item->query(normalized, exact);
 
-		// It is important that the 'result' won't relocate while inserting.
+		// In each item->query() result the list has no duplicates.
+		// So we need to check only for duplicates between queries.
+		const auto already = int(result.size());
 		result.reserve(result.size() + list.size());
-		const auto alreadyBegin = begin(result);
-		const auto alreadyEnd = alreadyBegin + result.size();
-
-		auto &&add = ranges::views::all(
-			list
-		) | ranges::views::filter([&](Result entry) {
-			// In each item->query() result the list has no duplicates.
-			// So we need to check only for duplicates between queries.
-			const auto i = ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji);
-			return (i == alreadyEnd);
-		});
-		result.insert(end(result), add.begin(), add.end());
+		for (const auto &entry : list) {
+			if (!added.contains(entry.emoji)) {
+				result.push_back(entry);
+			}
+		}
+		for (auto i = already, count = int(result.size()); i != count; ++i) {
+			added.emplace(result[i].emoji);
+		}
 	}
 	if (!exact) {
 		AppendLegacySuggestions(result, query);
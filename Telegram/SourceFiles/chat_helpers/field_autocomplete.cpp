@@ -420,7 +420,9 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			}
 		}
 		if (_chat) {
-			auto sorted = base::flat_multi_map<TimeId, not_null<UserData*>>();
+			// Sort once instead of inserting into a sorted container,
+			// equal online values keep the reversed participants order.
+			auto sorted = std::vector<std::pair<TimeId, not_null<UserData*>>>();
 			const auto byOnline = [&](not_null<UserData*> user) {
 				return Data::SortByOnlineValue(user, now);
 			};
@@ -428,23 +430,29 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			if (_chat->noParticipantInfo()) {
 				_chat->session().api().requestFullPeer(_chat);
 			} else if (!_chat->participants.empty()) {
+				sorted.reserve(_chat->participants.size());
 				for (const auto &user : _chat->participants) {
 					if (user->isInaccessible()) continue;
 					if (!listAllSuggestions && filterNotPassedByName(user)) continue;
 					if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-					sorted.emplace(byOnline(user), user);
+					sorted.emplace_back(byOnline(user), user);
 				}
+				ranges::stable_sort(sorted, ranges::less(), [](const auto &pair) {
+					return pair.first;
+				});
 			}
+			auto authors = base::flat_set<not_null<UserData*>>();
 			for (const auto user : _chat->lastAuthors) {
 				if (user->isInaccessible()) continue;
 				if (!listAllSuggestions && filterNotPassedByName(user)) continue;
 				if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
 				mrows.push_back({ user });
-				sorted.remove(byOnline(user), user);
+				authors.emplace(user);
 			}
-			for (auto i = sorted.cend(), b = sorted.cbegin(); i != b;) {
-				--i;
-				mrows.push_back({ i->second });
+			for (const auto &[online, user] : ranges::views::reverse(sorted)) {
+				if (!authors.contains(user)) {
+					mrows.push_back({ user });
+				}
 			}
 		} else if (_channel && _channel->isMegagroup()) {
 			if (_channel->lastParticipantsRequestNeeded()) {
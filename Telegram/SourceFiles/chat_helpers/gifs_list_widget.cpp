@@ -47,6 +47,7 @@ constexpr auto kSearchRequestDelay = 400;
 constexpr auto kSearchBotUsername = "gif"_cs;
 constexpr auto kMinRepaintDelay = crl::time(33);
 constexpr auto kMinAfterScrollDelay = crl::time(33);
+constexpr auto kUnloadHeavyPartsScreens = 2;
 
 } // namespace
 
@@ -242,6 +243,15 @@ void GifsListWidget::visibleTopBottomUpdated(
 	if (top != getVisibleTop()) {
 		_lastScrolledAt = crl::now();
 		update();
+
+		// Drop players and media of the rows far from the visible area,
+		// they load again from the cache when scrolled back.
+		const auto visibleHeight = visibleBottom - visibleTop;
+		const auto skip = visibleHeight * kUnloadHeavyPartsScreens;
+		_mosaic.forEachOutside(
+			visibleTop - skip,
+			visibleBottom + skip,
+			[](not_null<LayoutItem*> item) { item->unloadHeavyPart(); });
 	}
 	checkLoadMore();
 }
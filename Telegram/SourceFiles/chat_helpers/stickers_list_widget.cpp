@@ -56,6 +56,7 @@ constexpr auto kPreloadOfficialPages = 4;
 constexpr auto kOfficialLoadLimit = 40;
 constexpr auto kMinRepaintDelay = crl::time(33);
 constexpr auto kMinAfterScrollDelay = crl::time(33);
+constexpr auto kPrerenderLottieLimit = 12;
 
 using Data::StickersSet;
 using Data::StickersPack;
@@ -1260,6 +1261,7 @@ void StickersListWidget::preloadMoreOfficial() {
 					if (!covers.empty()) {
 						set->covers = covers;
 					}
+					set->materializeLocalStickers();
 					if (set->stickers.empty() && set->covers.empty()) {
 						continue;
 					}
@@ -1578,6 +1580,7 @@ void StickersListWidget::fillCloudSearchRows(
 }
 
 void StickersListWidget::addSearchRow(not_null<StickersSet*> set) {
+	set->materializeLocalStickers();
 	_searchSets.emplace_back(
 		set->id,
 		set,
@@ -1719,6 +1722,7 @@ void StickersListWidget::searchResultsDone(
 			if (!covers.empty()) {
 				set->covers = covers;
 			}
+			set->materializeLocalStickers();
 			if (set->stickers.empty() && set->covers.empty()) {
 				continue;
 			}
@@ -1935,6 +1939,64 @@ void StickersListWidget::checkVisibleLottie() {
 		}
 		return true;
 	});
+	prerenderLottieNear(visibleTop, visibleBottom);
+}
+
+void StickersListWidget::prerenderLottieNear(
+		int visibleTop,
+		int visibleBottom) {
+	// Set up animations of the rows about to scroll into view, so that
+	// the first frames are rendered and cached before they are painted.
+	auto &sets = shownSets();
+	const auto rowHeight = _singleSize.height();
+	const auto prerenderHeight = (visibleBottom - visibleTop) / 2;
+	const auto prerenderAbove = visibleTop - prerenderHeight;
+	const auto prerenderBelow = visibleBottom + prerenderHeight;
+	if (rowHeight <= 0 || prerenderHeight <= 0) {
+		return;
+	}
+	auto left = kPrerenderLottieLimit;
+	enumerateSections([&](const SectionInfo &info) {
+		if (prerenderBelow <= info.rowsTop
+			|| prerenderAbove >= info.rowsBottom) {
+			return true;
+		}
+		auto &set = sets[info.section];
+		const auto fromRow = std::max(
+			(prerenderAbove - info.rowsTop) / rowHeight,
+			0);
+		const auto tillRow = std::min(
+			(prerenderBelow - info.rowsTop + rowHeight - 1) / rowHeight,
+			info.rowsCount);
+		for (auto row = fromRow; row < tillRow; ++row) {
+			const auto top = info.rowsTop + row * rowHeight;
+			if (top < visibleBottom && top + rowHeight > visibleTop) {
+				continue;
+			}
+			for (auto column = 0; column != _columnCount; ++column) {
+				const auto index = row * _columnCount + column;
+				if (index >= info.count) {
+					break;
+				}
+				auto &sticker = set.stickers[index];
+				const auto data = sticker.document->sticker();
+				if (sticker.lottie || !data || !data->isLottie()) {
+					continue;
+				}
+				sticker.ensureMediaCreated();
+				sticker.documentMedia->checkStickerSmall();
+				if (!sticker.documentMedia->loaded()) {
+					continue;
+				}
+				setupLottie(set, info.section, index);
+				set.lottiePlayer->pause(sticker.lottie);
+				if (!--left) {
+					return false;
+				}
+			}
+		}
+		return true;
+	});
 }
 
 void StickersListWidget::clearHeavyIn(Set &set, bool clearSavedFrames) {
@@ -2837,6 +2899,7 @@ void StickersListWidget::refreshSearchSets() {
 		if (const auto it = sets.find(entry.id); it != sets.end()) {
 			const auto set = it->second.get();
 			entry.flags = set->flags;
+			set->materializeLocalStickers();
 			if (!set->stickers.empty()) {
 				entry.lottiePlayer = nullptr;
 				entry.stickers = PrepareStickers(set->stickers);
@@ -2898,8 +2961,11 @@ bool StickersListWidget::appendSet(
 		AppendSkip skip) {
 	const auto &sets = session().data().stickers().sets();
 	auto it = sets.find(setId);
-	if (it == sets.cend()
-		|| (!externalLayout && it->second->stickers.isEmpty())) {
+	if (it == sets.cend()) {
+		return false;
+	}
+	it->second->materializeLocalStickers();
+	if (!externalLayout && it->second->stickers.isEmpty()) {
 		return false;
 	}
 	const auto set = it->second.get();
@@ -3475,6 +3541,7 @@ void StickersListWidget::installSet(uint64 setId) {
 	if (it != sets.cend()) {
 		const auto set = it->second.get();
 		const auto input = set->mtpInput();
+		set->materializeLocalStickers();
 		if ((set->flags & SetFlag::NotLoaded) || set->stickers.empty()) {
 			_api.request(MTPmessages_GetStickerSet(
 				input,
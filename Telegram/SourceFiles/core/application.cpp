@@ -50,6 +50,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/file_utilities.h"
 #include "core/click_handler_types.h" // ClickHandlerContext.
 #include "core/crash_reports.h"
+#include "core/stall_detector.h"
+#include "core/startup_trace.h"
 #include "main/main_account.h"
 #include "main/main_domain.h"
 #include "main/main_session.h"
@@ -175,6 +177,8 @@ Application::Application(not_null<Launcher*> launcher)
 }
 
 Application::~Application() {
+	_stallDetector = nullptr;
+
 	if (_saveSettingsTimer && _saveSettingsTimer->isActive()) {
 		Local::writeSettings();
 	}
@@ -219,15 +223,21 @@ Application::~Application() {
 }
 
 void Application::run() {
-	style::internal::StartFonts();
+	{
+		const auto span = StartupTrace::Span("ThirdParty::start");
+		style::internal::StartFonts();
 
-	ThirdParty::start();
+		ThirdParty::start();
+	}
 
 	// Depends on OpenSSL on macOS, so on ThirdParty::start().
 	// Depends on notifications settings.
 	_notifications = std::make_unique<Window::Notifications::System>();
 
-	startLocalStorage();
+	{
+		const auto span = StartupTrace::Span("startLocalStorage");
+		startLocalStorage();
+	}
 	ValidateScale();
 
 	refreshGlobalProxy(); // Depends on app settings being read.
@@ -250,10 +260,13 @@ void Application::run() {
 	_translator = std::make_unique<Lang::Translator>();
 	QCoreApplication::instance()->installTranslator(_translator.get());
 
-	style::startManager(cScale());
-	Ui::InitTextOptions();
-	Ui::StartCachedCorners();
-	Ui::Emoji::Init();
+	{
+		const auto span = StartupTrace::Span("style::startManager");
+		style::startManager(cScale());
+		Ui::InitTextOptions();
+		Ui::StartCachedCorners();
+		Ui::Emoji::Init();
+	}
 	startEmojiImageLoader();
 	startSystemDarkModeViewer();
 	Media::Player::start(_audio.get());
@@ -277,7 +290,10 @@ void Application::run() {
 	// Create mime database, so it won't be slow later.
 	QMimeDatabase().mimeTypeForName(qsl("text/plain"));
 
-	_primaryWindow = std::make_unique<Window::Controller>();
+	{
+		const auto span = StartupTrace::Span("Window::Controller");
+		_primaryWindow = std::make_unique<Window::Controller>();
+	}
 	_lastActiveWindow = _primaryWindow.get();
 
 	_domain->activeChanges(
@@ -300,10 +316,16 @@ void Application::run() {
 
 	// Depend on activeWindow() for now :(
 	startShortcuts();
-	startDomain();
+	{
+		const auto span = StartupTrace::Span("Main::Domain::start");
+		startDomain();
+	}
 
 	startTray();
 
+	if (StartupTrace::Enabled()) {
+		traceFirstFrame();
+	}
 	_primaryWindow->widget()->show();
 
 	const auto currentGeometry = _primaryWindow->widget()->geometry();
@@ -342,6 +364,8 @@ void Application::run() {
 			[[maybe_unused]] const auto countriesCopy = countries;
 		});
 	}
+
+	_stallDetector = std::make_unique<StallDetector>();
 }
 
 void Application::showOpenGLCrashNotification() {
@@ -371,6 +395,19 @@ void Application::showOpenGLCrashNotification() {
 	}));
 }
 
+void Application::traceFirstFrame() {
+	_primaryWindow->widget()->events(
+	) | rpl::filter([](not_null<QEvent*> e) {
+		return (e->type() == QEvent::UpdateRequest)
+			|| (e->type() == QEvent::Paint);
+	}) | rpl::take(1) | rpl::start_with_next([=] {
+		// The event is handled right after the producer fires.
+		crl::on_main([] {
+			StartupTrace::Finish("MainWindow first frame");
+		});
+	}, _primaryWindow->widget()->lifetime());
+}
+
 void Application::startDomain() {
 	const auto state = _domain->start(QByteArray());
 	if (state != Storage::StartResult::IncorrectPasscodeLegacy) {
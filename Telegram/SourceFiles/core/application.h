@@ -104,6 +104,7 @@ namespace Core {
 class Launcher;
 struct LocalUrlHandler;
 class Tray;
+class StallDetector;
 
 enum class LaunchState {
 	Running,
@@ -319,6 +320,7 @@ private:
 	void startLocalStorage();
 	void startShortcuts();
 	void startDomain();
+	void traceFirstFrame();
 	void startEmojiImageLoader();
 	void startSystemDarkModeViewer();
 	void startTray();
@@ -383,6 +385,7 @@ private:
 	QPointer<Ui::BoxContent> _badProxyDisableBox;
 
 	const std::unique_ptr<Tray> _tray;
+	std::unique_ptr<StallDetector> _stallDetector;
 
 	std::unique_ptr<Media::Player::FloatController> _floatPlayers;
 	Media::Player::FloatDelegate *_defaultFloatPlayerDelegate = nullptr;
@@ -15,6 +15,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/platform/base_platform_info.h"
 #include "webrtc/webrtc_create_adm.h"
 #include "media/player/media_player_instance.h"
+#include "media/streaming/media_streaming_reader.h"
 #include "ui/gl/gl_detection.h"
 #include "calls/group/calls_group_common.h"
 #include "facades.h"
@@ -129,7 +130,8 @@ QByteArray Settings::serialize() const {
 		+ Serialize::bytearraySize(_photoEditorBrush)
 		+ sizeof(qint32) * 3
 		+ Serialize::stringSize(_customDeviceModel.current())
-		+ sizeof(qint32) * 4;
+		+ sizeof(qint32) * 4
+		+ sizeof(qint64);
 
 	auto result = QByteArray();
 	result.reserve(size);
@@ -241,7 +243,8 @@ QByteArray Settings::serialize() const {
 		stream
 			<< qint32(0) // old hardwareAcceleratedVideo
 			<< qint32(_chatQuickAction)
-			<< qint32(_hardwareAcceleratedVideo ? 1 : 0);
+			<< qint32(_hardwareAcceleratedVideo ? 1 : 0)
+			<< qint64(_streamingMemoryLimit);
 	}
 	return result;
 }
@@ -333,6 +336,7 @@ void Settings::addFromSerialized(const QByteArray &serialized) {
 	std::vector<uint64> accountsOrder;
 	qint32 hardwareAcceleratedVideo = _hardwareAcceleratedVideo ? 1 : 0;
 	qint32 chatQuickAction = static_cast<qint32>(_chatQuickAction);
+	qint64 streamingMemoryLimit = _streamingMemoryLimit;
 
 	stream >> themesAccentColors;
 	if (!stream.atEnd()) {
@@ -524,6 +528,9 @@ void Settings::addFromSerialized(const QByteArray &serialized) {
 	if (!stream.atEnd()) {
 		stream >> hardwareAcceleratedVideo;
 	}
+	if (!stream.atEnd()) {
+		stream >> streamingMemoryLimit;
+	}
 	if (stream.status() != QDataStream::Ok) {
 		LOG(("App Error: "
 			"Bad data for Core::Settings::constructFromSerialized()"));
@@ -681,6 +688,7 @@ void Settings::addFromSerialized(const QByteArray &serialized) {
 	}
 	_macWarnBeforeQuit = (macWarnBeforeQuit == 1);
 	_hardwareAcceleratedVideo = (hardwareAcceleratedVideo == 1);
+	setStreamingMemoryLimit(streamingMemoryLimit);
 	{
 		using Quick = HistoryView::DoubleClickQuickAction;
 		const auto uncheckedChatQuickAction = static_cast<Quick>(
@@ -693,6 +701,13 @@ void Settings::addFromSerialized(const QByteArray &serialized) {
 	}
 }
 
+void Settings::setStreamingMemoryLimit(int64 value) {
+	_streamingMemoryLimit = std::max(value, int64(0));
+	Media::Streaming::SetSlicesMemoryLimit(_streamingMemoryLimit
+		? _streamingMemoryLimit
+		: Media::Streaming::kDefaultSlicesMemoryLimit);
+}
+
 QString Settings::getSoundPath(const QString &key) const {
 	auto it = _soundOverrides.find(key);
 	if (it != _soundOverrides.end()) {
@@ -686,6 +686,11 @@ public:
 	[[nodiscard]] HistoryView::DoubleClickQuickAction chatQuickAction() const {
 		return _chatQuickAction;
 	}
+	// Memory shared by all streaming media readers, in bytes.
+	void setStreamingMemoryLimit(int64 value);
+	[[nodiscard]] int64 streamingMemoryLimit() const {
+		return _streamingMemoryLimit;
+	}
 
 	[[nodiscard]] static bool ThirdColumnByDefault();
 	[[nodiscard]] static float64 DefaultDialogsWidthRatio();
@@ -799,6 +804,7 @@ private:
 #endif // Q_OS_MAC
 	HistoryView::DoubleClickQuickAction _chatQuickAction =
 		HistoryView::DoubleClickQuickAction();
+	int64 _streamingMemoryLimit = 0;
 
 	bool _tabbedReplacedWithInfo = false; // per-window
 	rpl::event_stream<bool> _tabbedReplacedWithInfoValue; // per-window
@@ -252,6 +252,7 @@ void SignalHandler(int signum) {
 	const auto thread = QThread::currentThreadId();
 
 	if (ReportingThreadId.compare_exchange_strong(expected, thread)) {
+		Logs::flushBeforeCrash();
 		WriteReportInfo(signum, name);
 		ReportingThreadId = nullptr;
 	}
@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/crash_reports.h"
 #include "core/update_checker.h"
 #include "core/sandbox.h"
+#include "core/startup_trace.h"
 #include "base/concurrent_timer.h"
 #include "base/options.h"
 
@@ -341,7 +342,10 @@ int Launcher::exec() {
 	}
 
 	// Must be started before Sandbox is created.
-	Platform::start();
+	{
+		const auto span = StartupTrace::Span("Platform::start");
+		Platform::start();
+	}
 	auto result = executeApplication();
 
 	DEBUG_LOG(("Telegram finished, result: %1").arg(result));
@@ -480,6 +484,7 @@ void Launcher::processArguments() {
 		{ "-workdir"        , KeyFormat::OneValue },
 		{ "--"              , KeyFormat::OneValue },
 		{ "-scale"          , KeyFormat::OneValue },
+		{ "-starttrace"     , KeyFormat::OneValue },
 	};
 	auto parseResult = QMap<QByteArray, QStringList>();
 	auto parsingKey = QByteArray();
@@ -527,6 +532,9 @@ void Launcher::processArguments() {
 	}
 	gStartUrl = parseResult.value("--", {}).join(QString());
 
+	StartupTrace::Start(
+		parseResult.value("-starttrace", {}).join(QString()));
+
 	const auto scaleKey = parseResult.value("-scale", {});
 	if (scaleKey.size() > 0) {
 		const auto value = scaleKey[0].toInt();
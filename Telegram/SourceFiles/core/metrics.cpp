@@ -0,0 +1,51 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/metrics.h"
+
+#include <deque>
+#include <mutex>
+
+namespace Core::Metrics {
+namespace {
+
+struct Registry {
+	std::mutex mutex;
+	std::deque<std::atomic<int64>> values; // Stable element addresses.
+	base::flat_map<QString, not_null<std::atomic<int64>*>> byName;
+};
+
+[[nodiscard]] Registry &Instance() {
+	static auto result = Registry();
+	return result;
+}
+
+} // namespace
+
+std::atomic<int64> &Counter(const QString &name) {
+	auto &registry = Instance();
+	auto lock = std::lock_guard<std::mutex>(registry.mutex);
+	const auto i = registry.byName.find(name);
+	if (i != end(registry.byName)) {
+		return *i->second;
+	}
+	auto &result = registry.values.emplace_back(0);
+	registry.byName.emplace(name, &result);
+	return result;
+}
+
+QString Dump() {
+	auto &registry = Instance();
+	auto lock = std::lock_guard<std::mutex>(registry.mutex);
+	auto result = QString();
+	for (const auto &[name, value] : registry.byName) {
+		result += name + ": " + QString::number(value->load()) + '\n';
+	}
+	return result;
+}
+
+} // namespace Core::Metrics
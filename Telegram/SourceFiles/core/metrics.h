@@ -0,0 +1,25 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <atomic>
+
+namespace Core::Metrics {
+
+// Named process-wide values, updated from any thread without locking.
+//
+// static auto &Sent = Core::Metrics::Counter("upload.bytes");
+// Sent += size;
+//
+// The returned references stay valid until the process exits.
+[[nodiscard]] std::atomic<int64> &Counter(const QString &name);
+
+// "name: value" lines sorted by name, see the "metrics" settings code.
+[[nodiscard]] QString Dump();
+
+} // namespace Core::Metrics
@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/launcher.h"
 #include "core/local_url_handlers.h"
 #include "core/update_checker.h"
+#include "core/startup_trace.h"
 #include "base/timer.h"
 #include "base/concurrent_timer.h"
 #include "base/invoke_queued.h"
@@ -206,7 +207,10 @@ void Sandbox::launchApplication() {
 			Instance()._handleObservables.call();
 		});
 
-		_application = std::make_unique<Application>(_launcher);
+		{
+			const auto span = StartupTrace::Span("Application::Application");
+			_application = std::make_unique<Application>(_launcher);
+		}
 
 		// Ideally this should go to constructor.
 		// But we want to catch all native events and Application installs
@@ -214,6 +218,7 @@ void Sandbox::launchApplication() {
 		// our filter after the Application constructor installs his.
 		installNativeEventFilter(this);
 
+		const auto span = StartupTrace::Span("Application::run");
 		_application->run();
 	});
 }
@@ -0,0 +1,97 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/stall_detector.h"
+
+#include "core/crash_reports.h"
+
+#include <atomic>
+
+namespace Core {
+namespace {
+
+constexpr auto kStallThreshold = crl::time(1000);
+constexpr auto kStallThresholdDebug = crl::time(100);
+constexpr auto kAnnotationKey = "Last main thread stall";
+
+[[nodiscard]] crl::time Threshold() {
+	return Logs::DebugEnabled() ? kStallThresholdDebug : kStallThreshold;
+}
+
+[[nodiscard]] crl::time CheckInterval() {
+	// Don't wake up the idle main thread more often than needed.
+	return Threshold() / 2;
+}
+
+[[nodiscard]] bool LooksLikeSuspend(crl::time gap) {
+	// The watchdog thread itself didn't run, it was a system sleep.
+	return (gap > 10 * CheckInterval() + kStallThreshold);
+}
+
+} // namespace
+
+struct StallDetector::State {
+	std::atomic<crl::time> pingSent = 0; // Zero if the ping was answered.
+	std::atomic<bool> reported = false;
+};
+
+StallDetector::StallDetector()
+: _state(std::make_shared<State>())
+, _thread([=] { run(); }) {
+}
+
+StallDetector::~StallDetector() {
+	{
+		auto lock = std::lock_guard<std::mutex>(_mutex);
+		_finished = true;
+	}
+	_finishedChanged.notify_one();
+	_thread.join();
+}
+
+void StallDetector::run() {
+	const auto state = _state;
+	auto lock = std::unique_lock<std::mutex>(_mutex);
+	auto checked = crl::now();
+	while (!_finishedChanged.wait_for(
+			lock,
+			std::chrono::milliseconds(CheckInterval()),
+			[=] { return _finished; })) {
+		const auto now = crl::now();
+		const auto gap = now - std::exchange(checked, now);
+		const auto sent = state->pingSent.load();
+		if (sent && LooksLikeSuspend(gap)) {
+			// Measure the pending ping from the wake up,
+			// unless the main thread has just answered it.
+			auto expected = sent;
+			if (state->pingSent.compare_exchange_strong(expected, now)) {
+				state->reported = false;
+			}
+		} else if (!sent) {
+			state->pingSent = now;
+			crl::on_main([=] {
+				const auto sent = state->pingSent.exchange(0);
+				const auto stalled = crl::now() - sent;
+				if (!state->reported.exchange(false)
+					|| stalled < Threshold()) {
+					return;
+				}
+				LOG(("Stall Info: main thread was not responding for %1 ms."
+					).arg(stalled));
+				CrashReports::SetAnnotation(
+					kAnnotationKey,
+					QString("%1 ms at %2").arg(stalled).arg(sent));
+			});
+		} else if (!state->reported && now - sent >= Threshold()) {
+			state->reported = true;
+			LOG(("Stall Info: main thread is not responding for %1 ms."
+				).arg(now - sent));
+		}
+	}
+}
+
+} // namespace Core
@@ -0,0 +1,38 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Core {
+
+// Pings the main thread from a watchdog thread and logs the event loop
+// stalls, with the longer threshold unless debug logs are enabled.
+class StallDetector final {
+public:
+	StallDetector();
+	StallDetector(const StallDetector &other) = delete;
+	StallDetector &operator=(const StallDetector &other) = delete;
+	~StallDetector();
+
+private:
+	struct State;
+
+	void run();
+
+	const std::shared_ptr<State> _state;
+	std::mutex _mutex;
+	std::condition_variable _finishedChanged;
+	bool _finished = false;
+	std::thread _thread;
+
+};
+
+} // namespace Core
@@ -0,0 +1,140 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/startup_trace.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace Core::StartupTrace {
+namespace {
+
+constexpr auto kMaxEvents = 4096;
+
+struct Event {
+	const char *name = nullptr;
+	int64 started = 0;
+	int64 duration = -1; // Instant event.
+	int thread = 0;
+};
+
+std::atomic<bool> TraceEnabled/* = false*/;
+std::atomic<int> ThreadsCounter/* = 0*/;
+std::mutex EventsMutex;
+std::vector<Event> Events;
+QString TracePath;
+
+[[nodiscard]] int64 NowMicroseconds() {
+	using namespace std::chrono;
+	return duration_cast<microseconds>(
+		steady_clock::now().time_since_epoch()).count();
+}
+
+[[nodiscard]] int CurrentThread() {
+	thread_local const auto result = ++ThreadsCounter;
+	return result;
+}
+
+void Push(Event &&event) {
+	auto lock = std::lock_guard<std::mutex>(EventsMutex);
+	if (Events.size() < kMaxEvents) {
+		Events.push_back(std::move(event));
+	}
+}
+
+void Write(const QString &path, std::vector<Event> &&events) {
+	auto list = QJsonArray();
+	for (const auto &event : events) {
+		auto object = QJsonObject();
+		object.insert("name", QString::fromLatin1(event.name));
+		object.insert("cat", "startup");
+		object.insert("pid", 1);
+		object.insert("tid", event.thread);
+		object.insert("ts", double(event.started));
+		if (event.duration >= 0) {
+			object.insert("ph", "X");
+			object.insert("dur", double(event.duration));
+		} else {
+			object.insert("ph", "i");
+			object.insert("s", "g");
+		}
+		list.append(object);
+	}
+	auto document = QJsonObject();
+	document.insert("traceEvents", list);
+	document.insert("displayTimeUnit", "ms");
+
+	QFile f(path);
+	if (!f.open(QIODevice::WriteOnly)) {
+		LOG(("App Error: could not write startup trace to '%1'."
+			).arg(path));
+		return;
+	}
+	f.write(QJsonDocument(document).toJson(QJsonDocument::Compact));
+	LOG(("App Info: startup trace written to '%1'.").arg(path));
+}
+
+} // namespace
+
+void Start(const QString &path) {
+	if (path.isEmpty() || TraceEnabled) {
+		return;
+	}
+	TracePath = path;
+	Events.reserve(256);
+
+	// Main thread gets the first id.
+	CurrentThread();
+	TraceEnabled = true;
+}
+
+bool Enabled() {
+	return TraceEnabled;
+}
+
+void Finish(const char *name) {
+	if (!TraceEnabled.exchange(false)) {
+		return;
+	}
+	auto events = std::vector<Event>();
+	{
+		auto lock = std::lock_guard<std::mutex>(EventsMutex);
+		Events.push_back({
+			.name = name,
+			.started = NowMicroseconds(),
+			.thread = CurrentThread(),
+		});
+		events = base::take(Events);
+	}
+	Write(TracePath, std::move(events));
+}
+
+Span::Span(const char *name) {
+	if (TraceEnabled) {
+		_name = name;
+		_started = NowMicroseconds();
+	}
+}
+
+Span::~Span() {
+	if (_name && TraceEnabled) {
+		Push({
+			.name = _name,
+			.started = _started,
+			.duration = NowMicroseconds() - _started,
+			.thread = CurrentThread(),
+		});
+	}
+}
+
+} // namespace Core::StartupTrace
@@ -0,0 +1,33 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core::StartupTrace {
+
+// Records named spans of the app startup and writes them
+// as Chrome trace JSON, see the -starttrace command line argument.
+void Start(const QString &path);
+[[nodiscard]] bool Enabled();
+
+// Records an instant event and writes the trace file.
+void Finish(const char *name);
+
+class Span final {
+public:
+	explicit Span(const char *name);
+	Span(const Span &other) = delete;
+	Span &operator=(const Span &other) = delete;
+	~Span();
+
+private:
+	const char *_name = nullptr;
+	int64 _started = 0;
+
+};
+
+} // namespace Core::StartupTrace
@@ -18,7 +18,18 @@ public:
 		std::optional<int> fullCount,
 		std::optional<int> skippedBefore,
 		std::optional<int> skippedAfter)
-	: _ids(ids)
+	: AbstractSparseIds(
+		IdsContainer(ids),
+		fullCount,
+		skippedBefore,
+		skippedAfter) {
+	}
+	AbstractSparseIds(
+		IdsContainer &&ids,
+		std::optional<int> fullCount,
+		std::optional<int> skippedBefore,
+		std::optional<int> skippedAfter)
+	: _ids(std::make_shared<const IdsContainer>(std::move(ids)))
 	, _fullCount(fullCount)
 	, _skippedBefore(skippedBefore)
 	, _skippedAfter(skippedAfter) {
@@ -34,19 +45,27 @@ public:
 		return _skippedAfter;
 	}
 	[[nodiscard]] std::optional<int> indexOf(Id id) const {
-		const auto it = ranges::find(_ids, id);
-		if (it != _ids.end()) {
-			return (it - _ids.begin());
+		const auto &list = ids();
+		if constexpr (std::is_same_v<IdsContainer, base::flat_set<MsgId>>) {
+			const auto it = list.find(id);
+			if (it != list.end()) {
+				return (it - list.begin());
+			}
+		} else {
+			const auto it = ranges::find(list, id);
+			if (it != list.end()) {
+				return (it - list.begin());
+			}
 		}
 		return std::nullopt;
 	}
 	[[nodiscard]] int size() const {
-		return _ids.size();
+		return ids().size();
 	}
 	[[nodiscard]] Id operator[](int index) const {
 		Expects(index >= 0 && index < size());
 
-		return *(_ids.begin() + index);
+		return *(ids().begin() + index);
 	}
 	[[nodiscard]] std::optional<int> distance(Id a, Id b) const {
 		if (const auto i = indexOf(a)) {
@@ -58,20 +77,31 @@ public:
 	}
 	[[nodiscard]] std::optional<Id> nearest(Id id) const {
 		static_assert(std::is_same_v<IdsContainer, base::flat_set<MsgId>>);
-		if (const auto it = ranges::lower_bound(_ids, id); it != _ids.end()) {
+		const auto &list = ids();
+		if (const auto it = ranges::lower_bound(list, id); it != list.end()) {
 			return *it;
-		} else if (_ids.empty()) {
+		} else if (list.empty()) {
 			return std::nullopt;
 		}
-		return _ids.back();
+		return list.back();
 	}
 	void reverse() {
-		ranges::reverse(_ids);
+		if (_ids && !_ids->empty()) {
+			auto reversed = std::make_shared<IdsContainer>(*_ids);
+			ranges::reverse(*reversed);
+			_ids = std::move(reversed);
+		}
 		std::swap(_skippedBefore, _skippedAfter);
 	}
 
 private:
-	IdsContainer _ids;
+	[[nodiscard]] const IdsContainer &ids() const {
+		static const auto kEmpty = IdsContainer();
+		return _ids ? *_ids : kEmpty;
+	}
+
+	// Slices are copied to every viewer on each update, share the ids.
+	std::shared_ptr<const IdsContainer> _ids;
 	std::optional<int> _fullCount;
 	std::optional<int> _skippedBefore;
 	std::optional<int> _skippedAfter;
@@ -10,6 +10,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session.h"
 
 namespace Data {
+namespace {
+
+constexpr auto kBatchedDelay = crl::time(16);
+
+} // namespace
 
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::updated(
@@ -23,6 +28,7 @@ void Changes::Manager<DataType, UpdateType>::updated(
 			flags |= i->second;
 			_updates.erase(i);
 		}
+		_batched.remove(data);
 		_stream.fire({ data, flags });
 	} else {
 		_updates[data] |= flags;
@@ -76,14 +82,53 @@ rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::flagsValue(
 	) | rpl::then(updates(data, flags));
 }
 
+template <typename DataType, typename UpdateType>
+auto Changes::Manager<DataType, UpdateType>::updatesBatched(
+		Flags flags) const -> rpl::producer<std::vector<UpdateType>> {
+	return _batchedStream.events(
+	) | rpl::map([=](const std::vector<UpdateType> &list) {
+		return ranges::views::all(
+			list
+		) | ranges::views::filter([&](const UpdateType &update) {
+			return (update.flags & flags);
+		}) | ranges::to_vector;
+	}) | rpl::filter([](const std::vector<UpdateType> &list) {
+		return !list.empty();
+	});
+}
+
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::sendNotifications() {
+	const auto batch = _batchedStream.has_consumers();
 	for (const auto &[data, flags] : base::take(_updates)) {
+		if (batch) {
+			_batched[data] |= flags;
+		}
 		_stream.fire({ data, flags });
 	}
 }
 
-Changes::Changes(not_null<Main::Session*> session) : _session(session) {
+template <typename DataType, typename UpdateType>
+bool Changes::Manager<DataType, UpdateType>::hasBatched() const {
+	return !_batched.empty();
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::sendBatched() {
+	if (_batched.empty()) {
+		return;
+	}
+	auto list = std::vector<UpdateType>();
+	list.reserve(_batched.size());
+	for (const auto &[data, flags] : base::take(_batched)) {
+		list.push_back({ data, flags });
+	}
+	_batchedStream.fire(std::move(list));
+}
+
+Changes::Changes(not_null<Main::Session*> session)
+: _session(session)
+, _batchedTimer([=] { sendBatched(); }) {
 }
 
 Main::Session &Changes::session() const {
@@ -134,6 +179,11 @@ rpl::producer<PeerUpdate> Changes::realtimePeerUpdates(
 	return _peerChanges.realtimeUpdates(flag);
 }
 
+auto Changes::peerUpdatesBatched(PeerUpdate::Flags flags) const
+-> rpl::producer<std::vector<PeerUpdate>> {
+	return _peerChanges.updatesBatched(flags);
+}
+
 void Changes::historyUpdated(
 		not_null<History*> history,
 		HistoryUpdate::Flags flags) {
@@ -242,6 +292,21 @@ void Changes::sendNotifications() {
 	_historyChanges.sendNotifications();
 	_messageChanges.sendNotifications();
 	_entryChanges.sendNotifications();
+
+	if (!_batchedTimer.isActive()
+		&& (_peerChanges.hasBatched()
+			|| _historyChanges.hasBatched()
+			|| _messageChanges.hasBatched()
+			|| _entryChanges.hasBatched())) {
+		_batchedTimer.callOnce(kBatchedDelay);
+	}
+}
+
+void Changes::sendBatched() {
+	_peerChanges.sendBatched();
+	_historyChanges.sendBatched();
+	_messageChanges.sendBatched();
+	_entryChanges.sendBatched();
 }
 
 } // namespace Data
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/flags.h"
+#include "base/timer.h"
 
 class History;
 class PeerData;
@@ -204,6 +205,10 @@ public:
 	[[nodiscard]] rpl::producer<PeerUpdate> realtimePeerUpdates(
 		PeerUpdate::Flag flag) const;
 
+	// All updates collected during one frame come in a single vector.
+	[[nodiscard]] auto peerUpdatesBatched(PeerUpdate::Flags flags) const
+	-> rpl::producer<std::vector<PeerUpdate>>;
+
 	void historyUpdated(
 		not_null<History*> history,
 		HistoryUpdate::Flags flags);
@@ -268,8 +273,12 @@ private:
 			Flags flags) const;
 		[[nodiscard]] rpl::producer<UpdateType> realtimeUpdates(
 			Flag flag) const;
+		[[nodiscard]] auto updatesBatched(Flags flags) const
+		-> rpl::producer<std::vector<UpdateType>>;
 
 		void sendNotifications();
+		[[nodiscard]] bool hasBatched() const;
+		void sendBatched();
 
 	private:
 		static constexpr auto kCount = details::CountBit<Flag>() + 1;
@@ -281,10 +290,13 @@ private:
 		std::array<rpl::event_stream<UpdateType>, kCount> _realtimeStreams;
 		base::flat_map<not_null<DataType*>, Flags> _updates;
 		rpl::event_stream<UpdateType> _stream;
+		base::flat_map<not_null<DataType*>, Flags> _batched;
+		rpl::event_stream<std::vector<UpdateType>> _batchedStream;
 
 	};
 
 	void scheduleNotifications();
+	void sendBatched();
 
 	const not_null<Main::Session*> _session;
 
@@ -294,6 +306,7 @@ private:
 	Manager<HistoryItem, MessageUpdate> _messageChanges;
 	Manager<Dialogs::Entry, EntryUpdate> _entryChanges;
 
+	base::Timer _batchedTimer;
 	bool _notify = false;
 
 };
@@ -175,8 +175,9 @@ const base::flat_set<not_null<History*>> &ChatFilter::never() const {
 	return _never;
 }
 
-bool ChatFilter::contains(not_null<History*> history) const {
-	const auto flag = [&] {
+ChatFilter::HistoryState ChatFilter::ComputeState(
+		not_null<History*> history) {
+	const auto type = [&] {
 		const auto peer = history->peer;
 		if (const auto user = peer->asUser()) {
 			return user->isBot()
@@ -193,26 +194,37 @@ bool ChatFilter::contains(not_null<History*> history) const {
 				return Flag::Groups;
 			}
 		} else {
-			Unexpected("Peer type in ChatFilter::contains.");
+			Unexpected("Peer type in ChatFilter::ComputeState.");
 		}
 	}();
+	const auto inMain = history->folderKnown() && !history->folder();
+	return {
+		.type = type,
+		.muted = (history->mute()
+			&& !(history->unreadMentions().has() && inMain)),
+		.read = !history->unreadCount()
+			&& !history->unreadMark()
+			&& !history->unreadMentions().has()
+			&& !history->fakeUnreadWhileOpened(),
+		.archived = !inMain,
+	};
+}
+
+bool ChatFilter::contains(not_null<History*> history) const {
+	return contains(history, ComputeState(history));
+}
+
+bool ChatFilter::contains(
+		not_null<History*> history,
+		const HistoryState &state) const {
 	if (_never.contains(history)) {
 		return false;
 	}
 	return false
-		|| ((_flags & flag)
-			&& (!(_flags & Flag::NoMuted)
-				|| !history->mute()
-				|| (history->unreadMentions().has()
-					&& history->folderKnown()
-					&& !history->folder()))
-			&& (!(_flags & Flag::NoRead)
-				|| history->unreadCount()
-				|| history->unreadMark()
-				|| history->unreadMentions().has()
-				|| history->fakeUnreadWhileOpened())
-			&& (!(_flags & Flag::NoArchived)
-				|| (history->folderKnown() && !history->folder())))
+		|| ((_flags & state.type)
+			&& (!(_flags & Flag::NoMuted) || !state.muted)
+			&& (!(_flags & Flag::NoRead) || !state.read)
+			&& (!(_flags & Flag::NoArchived) || !state.archived))
 		|| _always.contains(history);
 }
 
@@ -60,7 +60,20 @@ public:
 	[[nodiscard]] const std::vector<not_null<History*>> &pinned() const;
 	[[nodiscard]] const base::flat_set<not_null<History*>> &never() const;
 
+	// What contains() checks in a history, computed once for all filters.
+	struct HistoryState {
+		Flag type = Flag();
+		bool muted = false;
+		bool read = false;
+		bool archived = false;
+	};
+	[[nodiscard]] static HistoryState ComputeState(
+		not_null<History*> history);
+
 	[[nodiscard]] bool contains(not_null<History*> history) const;
+	[[nodiscard]] bool contains(
+		not_null<History*> history,
+		const HistoryState &state) const;
 
 private:
 	FilterId _id = 0;
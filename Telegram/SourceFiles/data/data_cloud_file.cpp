@@ -245,6 +245,12 @@ void LoadCloudFile(
 		if (file.loader->loadSize() < loadSize) {
 			file.loader->increaseLoadSize(loadSize, autoLoading);
 		}
+		if (file.loader->lowPriority()
+			&& !(file.flags & CloudFile::Flag::LowPriority)) {
+			// Requested not only in background now, move it up the queue.
+			file.loader->setLowPriority(false);
+			file.loader->start();
+		}
 		return;
 	} else if ((file.flags & CloudFile::Flag::Failed)
 		|| !file.location.valid()
@@ -264,6 +270,8 @@ void LoadCloudFile(
 		fromCloud,
 		autoLoading,
 		cacheTag);
+	file.loader->setLowPriority(
+		(file.flags & CloudFile::Flag::LowPriority) != 0);
 
 	const auto finish = [done](CloudFile &file) {
 		if (!file.loader || file.loader->cancelled()) {
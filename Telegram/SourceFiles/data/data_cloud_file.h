@@ -32,6 +32,7 @@ struct CloudFile final {
 		Cancelled = 0x01,
 		Failed = 0x02,
 		Loaded = 0x04,
+		LowPriority = 0x08,
 	};
 	friend inline constexpr bool is_flag_type(Flag) { return true; };
 
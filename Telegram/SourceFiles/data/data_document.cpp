@@ -826,11 +826,15 @@ void DocumentData::save(
 		Data::FileOrigin origin,
 		const QString &toFile,
 		LoadFromCloudSetting fromCloud,
-		bool autoLoading) {
-	if (const auto media = activeMediaView(); media && media->loaded(true)) {
+		bool autoLoading,
+		bool lowPriority) {
+	const auto media = activeMediaView();
+	if (media ? media->loaded(true) : !filepath(true).isEmpty()) {
+		// Saving a copy of an already downloaded file shouldn't require
+		// a media view, otherwise we would download it once again.
 		auto &l = location(true);
 		if (!toFile.isEmpty()) {
-			if (!media->bytes().isEmpty()) {
+			if (media && !media->bytes().isEmpty()) {
 				QFile f(toFile);
 				f.open(QIODevice::WriteOnly);
 				f.write(media->bytes());
@@ -863,6 +867,10 @@ void DocumentData::save(
 		if (fromCloud == LoadFromCloudOrLocal) {
 			_loader->permitLoadFromCloud();
 		}
+		if (!lowPriority) {
+			// start() below moves it up the queue if it was low priority.
+			_loader->setLowPriority(false);
+		}
 	} else {
 		status = FileReady;
 		auto reader = owner().streaming().sharedReader(this, origin, true);
@@ -920,6 +928,7 @@ void DocumentData::save(
 				autoLoading,
 				cacheTag());
 		}
+		_loader->setLowPriority(lowPriority);
 		handleLoaderUpdates();
 	}
 	if (loading()) {
@@ -113,7 +113,8 @@ public:
 		Data::FileOrigin origin,
 		const QString &toFile,
 		LoadFromCloudSetting fromCloud = LoadFromCloudOrLocal,
-		bool autoLoading = false);
+		bool autoLoading = false,
+		bool lowPriority = false);
 	void cancel();
 	[[nodiscard]] bool cancelled() const;
 	[[nodiscard]] float64 progress() const;
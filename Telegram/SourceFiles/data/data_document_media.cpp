@@ -34,6 +34,7 @@ namespace {
 constexpr auto kReadAreaLimit = 12'032 * 9'024;
 constexpr auto kWallPaperThumbnailLimit = 960;
 constexpr auto kGoodThumbQuality = 87;
+constexpr auto kGoodThumbMaxGenerating = 2;
 
 enum class FileType {
 	Video,
@@ -100,6 +101,44 @@ enum class FileType {
 		: result;
 }
 
+// Good thumbnails are generated from the main thread only.
+struct GoodThumbTask {
+	base::weak_ptr<Main::Session> guard;
+	FnMut<void()> generate;
+};
+auto GoodThumbGenerating = 0;
+auto GoodThumbQueue = std::vector<GoodThumbTask>();
+
+void GoodThumbGenerate(GoodThumbTask task) {
+	GoodThumbQueue.erase(
+		ranges::remove_if(GoodThumbQueue, [](const GoodThumbTask &task) {
+			return !task.guard;
+		}),
+		end(GoodThumbQueue));
+	if (GoodThumbGenerating < kGoodThumbMaxGenerating) {
+		++GoodThumbGenerating;
+		task.generate();
+	} else {
+		GoodThumbQueue.push_back(std::move(task));
+	}
+}
+
+void GoodThumbGenerated() {
+	Expects(GoodThumbGenerating > 0);
+
+	--GoodThumbGenerating;
+	while (!GoodThumbQueue.empty()) {
+		// The most recently requested ones are most likely on screen.
+		auto task = std::move(GoodThumbQueue.back());
+		GoodThumbQueue.pop_back();
+		if (task.guard) {
+			++GoodThumbGenerating;
+			task.generate();
+			return;
+		}
+	}
+}
+
 } // namespace
 
 VideoPreviewState::VideoPreviewState(DocumentMedia *media)
@@ -281,7 +320,8 @@ void DocumentMedia::checkStickerLarge() {
 
 void DocumentMedia::automaticLoad(
 		Data::FileOrigin origin,
-		const HistoryItem *item) {
+		const HistoryItem *item,
+		bool lowPriority) {
 	if (_owner->status != FileReady || loaded() || _owner->cancelled()) {
 		return;
 	} else if (!item && !_owner->sticker() && !_owner->isAnimation()) {
@@ -308,11 +348,18 @@ void DocumentMedia::automaticLoad(
 	const auto loadFromCloud = shouldLoadFromCloud
 		? LoadFromCloudOrLocal
 		: LoadFromLocalOnly;
+
+	// Stickers and GIFs are shown right away, they shouldn't wait.
+	const auto background = lowPriority
+		&& item
+		&& !_owner->sticker()
+		&& !_owner->isAnimation();
 	_owner->save(
 		origin,
 		filename,
 		loadFromCloud,
-		true);
+		true,
+		background);
 }
 
 void DocumentMedia::collectLocalData(not_null<DocumentMedia*> local) {
@@ -427,38 +474,47 @@ void DocumentMedia::GenerateGoodThumbnail(
 		return;
 	}
 	const auto guard = base::make_weak(&document->owner().session());
-	crl::async([=, location = std::move(location)] {
-		const auto filepath = (location && location->accessEnable())
-			? location->name()
-			: QString();
-		auto result = PrepareGoodThumbnail(filepath, data, type);
-		auto bytes = QByteArray();
-		if (!result.isNull()) {
-			auto buffer = QBuffer(&bytes);
-			const auto format = (type == FileType::AnimatedSticker
-				|| type == FileType::VideoSticker)
-				? "WEBP"
-				: (type == FileType::WallPatternPNG
-					|| type == FileType::WallPatternSVG)
-				? "PNG"
-				: "JPG";
-			result.save(&buffer, format, kGoodThumbQuality);
-		}
-		if (!filepath.isEmpty()) {
-			location->accessDisable();
-		}
-		const auto cache = bytes.isEmpty() ? QByteArray("(failed)") : bytes;
-		crl::on_main(guard, [=] {
-			document->setGoodThumbnailChecked(true);
-			if (const auto active = document->activeMediaView()) {
-				active->setGoodThumbnail(result);
+	auto generate = [=, location = std::move(location)]() mutable {
+		crl::async([=, location = std::move(location)] {
+			const auto filepath = (location && location->accessEnable())
+				? location->name()
+				: QString();
+			auto result = PrepareGoodThumbnail(filepath, data, type);
+			auto bytes = QByteArray();
+			if (!result.isNull()) {
+				auto buffer = QBuffer(&bytes);
+				const auto format = (type == FileType::AnimatedSticker
+					|| type == FileType::VideoSticker)
+					? "WEBP"
+					: (type == FileType::WallPatternPNG
+						|| type == FileType::WallPatternSVG)
+					? "PNG"
+					: "JPG";
+				result.save(&buffer, format, kGoodThumbQuality);
+			}
+			if (!filepath.isEmpty()) {
+				location->accessDisable();
 			}
-			document->owner().cache().put(
-				document->goodThumbnailCacheKey(),
-				Storage::Cache::Database::TaggedValue{
-					base::duplicate(cache),
-					kImageCacheTag });
+			const auto cache = bytes.isEmpty()
+				? QByteArray("(failed)")
+				: bytes;
+			crl::on_main(guard, [=] {
+				document->setGoodThumbnailChecked(true);
+				if (const auto active = document->activeMediaView()) {
+					active->setGoodThumbnail(result);
+				}
+				document->owner().cache().put(
+					document->goodThumbnailCacheKey(),
+					Storage::Cache::Database::TaggedValue{
+						base::duplicate(cache),
+						kImageCacheTag });
+			});
+			crl::on_main(GoodThumbGenerated);
 		});
+	};
+	GoodThumbGenerate({
+		.guard = guard,
+		.generate = std::move(generate),
 	});
 }
 
@@ -76,7 +76,10 @@ public:
 	[[nodiscard]] float64 progress() const;
 	[[nodiscard]] bool canBePlayed(HistoryItem *item) const;
 
-	void automaticLoad(Data::FileOrigin origin, const HistoryItem *item);
+	void automaticLoad(
+		Data::FileOrigin origin,
+		const HistoryItem *item,
+		bool lowPriority = true);
 
 	void collectLocalData(not_null<DocumentMedia*> local);
 
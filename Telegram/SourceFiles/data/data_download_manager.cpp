@@ -107,8 +107,6 @@ DownloadManager::~DownloadManager() = default;
 
 void DownloadManager::trackSession(not_null<Main::Session*> session) {
 	auto &data = _sessions.emplace(session, SessionData()).first->second;
-	data.downloaded = deserialize(session);
-	data.resolveNeeded = data.downloaded.size();
 
 	session->data().documentLoadProgress(
 	) | rpl::filter([=](not_null<DocumentData*> document) {
@@ -351,6 +349,7 @@ void DownloadManager::deleteFiles(const std::vector<GlobalMsgId> &ids) {
 				continue;
 			}
 			auto &data = i->second;
+			ensureDeserialized(session, data);
 			const auto j = ranges::find(
 				data.downloading,
 				not_null{ item },
@@ -385,6 +384,7 @@ void DownloadManager::deleteFiles(const std::vector<GlobalMsgId> &ids) {
 void DownloadManager::deleteAll() {
 	auto descriptor = DeleteFilesDescriptor();
 	for (auto &[session, data] : _sessions) {
+		ensureDeserialized(session, data);
 		if (!data.downloaded.empty()) {
 			descriptor.sessions.emplace(session);
 		} else if (data.downloading.empty()) {
@@ -444,6 +444,7 @@ void DownloadManager::finishFilesDelete(DeleteFilesDescriptor &&descriptor) {
 
 bool DownloadManager::loadedHasNonCloudFile() const {
 	for (const auto &[session, data] : _sessions) {
+		ensureDeserialized(session, data);
 		for (const auto &id : data.downloaded) {
 			if (const auto object = id.object.get()) {
 				if (!object->item->isHistoryEntry()) {
@@ -581,6 +582,7 @@ void DownloadManager::clearLoading() {
 auto DownloadManager::loadedList()
 -> ranges::any_view<const DownloadedId*, ranges::category::input> {
 	for (auto &[session, data] : _sessions) {
+		ensureDeserialized(session, data);
 		resolve(session, data);
 	}
 	return ranges::views::all(
@@ -903,6 +905,7 @@ DownloadManager::SessionData &DownloadManager::sessionData(
 		not_null<Main::Session*> session) {
 	const auto i = _sessions.find(session);
 	Assert(i != end(_sessions));
+	ensureDeserialized(session, i->second);
 	return i->second;
 }
 
@@ -910,6 +913,7 @@ const DownloadManager::SessionData &DownloadManager::sessionData(
 		not_null<Main::Session*> session) const {
 	const auto i = _sessions.find(session);
 	Assert(i != end(_sessions));
+	ensureDeserialized(session, i->second);
 	return i->second;
 }
 
@@ -974,6 +978,20 @@ Fn<std::optional<QByteArray>()> DownloadManager::serializator(
 	};
 }
 
+void DownloadManager::ensureDeserialized(
+		not_null<Main::Session*> session,
+		const SessionData &data) const {
+	if (data.deserialized) {
+		return;
+	}
+	data.deserialized = true;
+
+	// Saved downloads live in the locations file, read them only when
+	// the list is first needed instead of right after the session start.
+	data.downloaded = deserialize(session);
+	data.resolveNeeded = data.downloaded.size();
+}
+
 std::vector<DownloadedId> DownloadManager::deserialize(
 		not_null<Main::Session*> session) const {
 	const auto serialized = session->account().local().downloadsSerialized();
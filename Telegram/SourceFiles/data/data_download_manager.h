@@ -120,11 +120,13 @@ public:
 private:
 	struct DeleteFilesDescriptor;
 	struct SessionData {
-		std::vector<DownloadedId> downloaded;
+		// Read from local storage on the first access, const one as well.
+		mutable std::vector<DownloadedId> downloaded;
 		std::vector<DownloadingId> downloading;
-		int resolveNeeded = 0;
+		mutable int resolveNeeded = 0;
 		int resolveSentRequests = 0;
 		int resolveSentTotal = 0;
+		mutable bool deserialized = false;
 		rpl::lifetime lifetime;
 	};
 
@@ -176,6 +178,9 @@ private:
 	void writePostponed(not_null<Main::Session*> session);
 	[[nodiscard]] Fn<std::optional<QByteArray>()> serializator(
 		not_null<Main::Session*> session) const;
+	void ensureDeserialized(
+		not_null<Main::Session*> session,
+		const SessionData &data) const;
 	[[nodiscard]] std::vector<DownloadedId> deserialize(
 		not_null<Main::Session*> session) const;
 
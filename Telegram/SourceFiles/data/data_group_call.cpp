@@ -242,10 +242,18 @@ const GroupCallParticipant *GroupCall::participantByPeer(
 
 GroupCallParticipant *GroupCall::findParticipant(
 		not_null<PeerData*> peer) {
-	const auto i = ranges::find(_participants, peer, &Participant::peer);
+	const auto i = findParticipantIterator(peer);
 	return (i != end(_participants)) ? &*i : nullptr;
 }
 
+auto GroupCall::findParticipantIterator(not_null<PeerData*> peer)
+-> std::vector<Participant>::iterator {
+	const auto i = _participantIndexByPeer.find(peer);
+	return (i != end(_participantIndexByPeer))
+		? (begin(_participants) + i->second)
+		: end(_participants);
+}
+
 const GroupCallParticipant *GroupCall::participantByEndpoint(
 		const std::string &endpoint) const {
 	if (endpoint.empty()) {
@@ -368,6 +376,7 @@ void GroupCall::processFullCallFields(const MTPphone_GroupCall &call) {
 		const auto nextOffset = qs(data.vparticipants_next_offset());
 		data.vcall().match([&](const MTPDgroupCall &data) {
 			_participants.clear();
+			_participantIndexByPeer.clear();
 			_speakingByActiveFinishes.clear();
 			_participantPeerByAudioSsrc.clear();
 			_allParticipantsLoaded = false;
@@ -568,10 +577,7 @@ void GroupCall::applyParticipantsSlice(
 			const auto participantPeerId = peerFromMTP(data.vpeer());
 			const auto participantPeer = _peer->owner().peer(
 				participantPeerId);
-			const auto i = ranges::find(
-				_participants,
-				participantPeer,
-				&Participant::peer);
+			const auto i = findParticipantIterator(participantPeer);
 			if (data.is_left()) {
 				if (i != end(_participants)) {
 					auto update = ParticipantUpdate{
@@ -581,7 +587,14 @@ void GroupCall::applyParticipantsSlice(
 					_participantPeerByAudioSsrc.erase(
 						GetAdditionalAudioSsrc(i->videoParams));
 					_speakingByActiveFinishes.remove(participantPeer);
+					const auto index = int(i - begin(_participants));
 					_participants.erase(i);
+					_participantIndexByPeer.remove(participantPeer);
+					for (auto &[peer, later] : _participantIndexByPeer) {
+						if (later > index) {
+							--later;
+						}
+					}
 					if (sliceSource != ApplySliceSource::FullReloaded) {
 						_participantUpdates.fire(std::move(update));
 					}
@@ -663,6 +676,9 @@ void GroupCall::applyParticipantsSlice(
 						additional,
 						participantPeer);
 				}
+				_participantIndexByPeer.emplace(
+					participantPeer,
+					int(_participants.size()));
 				_participants.push_back(value);
 				if (const auto user = participantPeer->asUser()) {
 					_peer->owner().unregisterInvitedToCallUser(_id, user);
@@ -915,10 +931,8 @@ void GroupCall::requestUnknownParticipants() {
 		}
 		for (const auto &[id, when] : participantPeerIds) {
 			if (const auto participantPeer = _peer->owner().peerLoaded(id)) {
-				const auto isParticipant = ranges::contains(
-					_participants,
-					not_null{ participantPeer },
-					&Participant::peer);
+				const auto isParticipant = _participantIndexByPeer.contains(
+					not_null{ participantPeer });
 				if (isParticipant) {
 					applyActiveUpdate(id, when, participantPeer);
 				}
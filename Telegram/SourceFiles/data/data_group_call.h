@@ -199,6 +199,8 @@ private:
 	[[nodiscard]] bool processSavedFullCall();
 	void finishParticipantsSliceRequest();
 	[[nodiscard]] Participant *findParticipant(not_null<PeerData*> peer);
+	[[nodiscard]] auto findParticipantIterator(not_null<PeerData*> peer)
+		-> std::vector<Participant>::iterator;
 
 	const CallId _id = 0;
 	const CallId _accessHash = 0;
@@ -217,6 +219,7 @@ private:
 	std::optional<MTPphone_GroupCall> _savedFull;
 
 	std::vector<Participant> _participants;
+	base::flat_map<not_null<PeerData*>, int> _participantIndexByPeer;
 	base::flat_map<uint32, not_null<PeerData*>> _participantPeerByAudioSsrc;
 	base::flat_map<not_null<PeerData*>, crl::time> _speakingByActiveFinishes;
 	base::Timer _speakingByActiveFinishTimer;
@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_chat.h"
 #include "data/data_folder.h"
 #include "data/data_scheduled_messages.h"
+#include "dialogs/dialogs_main_list.h"
 #include "base/unixtime.h"
 #include "main/main_session.h"
 #include "window/notifications_manager.h"
@@ -25,12 +26,20 @@ namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kReadRequestsBatchWindow = crl::time(500);
+constexpr auto kReadRequestSendDelay = crl::time(5);
+constexpr auto kPreloadHistoriesCount = 4;
+constexpr auto kPreloadMessagesCount = 30;
+constexpr auto kUnloadClosedDelay = 30 * crl::time(1000);
+constexpr auto kClosedElementsBudget = 4000;
+constexpr auto kDeleteMessagesPerRequest = 100;
 
 } // namespace
 
 Histories::Histories(not_null<Session*> owner)
 : _owner(owner)
-, _readRequestsTimer([=] { sendReadRequests(); }) {
+, _readRequestsTimer([=] { sendReadRequests(); })
+, _unloadClosedTimer([=] { checkUnloadClosed(); }) {
 }
 
 Session &Histories::owner() const {
@@ -59,15 +68,62 @@ not_null<History*> Histories::findOrCreate(PeerId peerId) {
 }
 
 void Histories::unloadAll() {
+	_closedAt.clear();
 	for (const auto &[peerId, history] : _map) {
 		history->clear(History::ClearType::Unload);
 	}
 }
 
 void Histories::clearAll() {
+	_opened.clear();
+	_closedAt.clear();
 	_map.clear();
 }
 
+void Histories::setOpened(not_null<History*> history, bool opened) {
+	if (opened) {
+		_opened.emplace(history);
+		_closedAt.remove(history);
+	} else if (_opened.remove(history)) {
+		_closedAt[history] = crl::now();
+		if (!_unloadClosedTimer.isActive()) {
+			_unloadClosedTimer.callOnce(kUnloadClosedDelay);
+		}
+	}
+}
+
+void Histories::checkUnloadClosed() {
+	const auto count = [](not_null<History*> history) {
+		auto result = 0;
+		for (const auto &block : history->blocks) {
+			result += int(block->messages.size());
+		}
+		return result;
+	};
+	auto total = 0;
+	auto order = std::vector<std::pair<crl::time, not_null<History*>>>();
+	order.reserve(_closedAt.size());
+	for (const auto &[history, when] : _closedAt) {
+		total += count(history);
+		order.emplace_back(when, history);
+	}
+	ranges::sort(order);
+
+	// Only the chats that stayed closed for the whole delay are unloaded.
+	const auto now = crl::now();
+	for (const auto &[when, history] : order) {
+		if (total <= kClosedElementsBudget) {
+			return;
+		} else if (when + kUnloadClosedDelay > now) {
+			_unloadClosedTimer.callOnce(when + kUnloadClosedDelay - now);
+			return;
+		}
+		total -= count(history);
+		_closedAt.remove(history);
+		history->clear(History::ClearType::Unload);
+	}
+}
+
 void Histories::readInbox(not_null<History*> history) {
 	DEBUG_LOG(("Reading: readInbox called."));
 	if (history->lastServerMessageKnown()) {
@@ -439,6 +495,73 @@ void Histories::requestFakeChatListMessage(
 	});
 }
 
+void Histories::preloadTopHistories() {
+	auto left = kPreloadHistoriesCount;
+	for (const auto &row : *_owner->chatsList()->indexed()) {
+		if (!left) {
+			break;
+		}
+		const auto history = row->history();
+		if (!history) {
+			continue;
+		}
+		--left;
+		if (!history->isEmpty() || _preloadRequests.contains(history)) {
+			continue;
+		}
+		_preloadRequests.emplace(history);
+		sendRequest(history, RequestType::History, [=](Fn<void()> finish) {
+			return session().api().request(MTPmessages_GetHistory(
+				history->peer->input,
+				MTP_int(0), // offset_id
+				MTP_int(0), // offset_date
+				MTP_int(0), // add_offset
+				MTP_int(kPreloadMessagesCount),
+				MTP_int(0), // max_id
+				MTP_int(0), // min_id
+				MTP_long(0) // hash
+			)).done([=](const MTPmessages_Messages &result) {
+				_preloadRequests.erase(history);
+				applyPreloaded(history, result);
+				finish();
+			}).fail([=] {
+				_preloadRequests.erase(history);
+				finish();
+			}).send();
+		});
+	}
+}
+
+void Histories::applyPreloaded(
+		not_null<History*> history,
+		const MTPmessages_Messages &result) {
+	// If the chat was opened meanwhile, it loads the messages by itself.
+	const auto state = lookup(history);
+	const auto loading = state
+		? ranges::count(
+			state->sent,
+			RequestType::History,
+			[](const auto &pair) { return pair.second.type; })
+		: 0;
+	if (loading > 1 || !history->isEmpty()) {
+		return;
+	}
+	const auto apply = [&](const auto &data) {
+		_owner->processUsers(data.vusers());
+		_owner->processChats(data.vchats());
+		history->addOlderSlice(data.vmessages().v);
+	};
+	result.match([&](const MTPDmessages_messagesNotModified &) {
+	}, [&](const MTPDmessages_channelMessages &data) {
+		if (const auto channel = history->peer->asChannel()) {
+			channel->ptsReceived(data.vpts().v);
+		}
+		apply(data);
+	}, [&](const auto &data) {
+		apply(data);
+	});
+}
+
 void Histories::requestGroupAround(not_null<HistoryItem*> item) {
 	const auto history = item->history();
 	const auto id = item->id;
@@ -505,7 +628,8 @@ void Histories::sendReadRequests() {
 		if (!state.willReadTill) {
 			DEBUG_LOG(("Reading: skipping zero till."));
 			continue;
-		} else if (state.willReadWhen <= now) {
+		} else if (state.willReadWhen <= now + kReadRequestsBatchWindow) {
+			// Send the almost due ones as well, so they go in one container.
 			DEBUG_LOG(("Reading: sending with till %1."
 				).arg(state.willReadTill.bare));
 			sendReadRequest(history, state);
@@ -553,7 +677,9 @@ void Histories::sendReadRequest(not_null<History*> history, State &state) {
 			return session().api().request(MTPchannels_ReadHistory(
 				channel->inputChannel,
 				MTP_int(tillId)
-			)).done(finished).fail(finished).send();
+			)).done(finished).fail(finished).afterDelay(
+				kReadRequestSendDelay
+			).send();
 		} else {
 			return session().api().request(MTPmessages_ReadHistory(
 				history->peer->input,
@@ -563,7 +689,7 @@ void Histories::sendReadRequest(not_null<History*> history, State &state) {
 				finished();
 			}).fail([=] {
 				finished();
-			}).send();
+			}).afterDelay(kReadRequestSendDelay).send();
 		}
 	});
 }
@@ -600,23 +726,53 @@ void Histories::deleteMessages(
 		not_null<History*> history,
 		const QVector<MTPint> &ids,
 		bool revoke) {
+	deleteMessagesChunk(history, ids, revoke, false);
+}
+
+void Histories::deleteMessagesChunk(
+		not_null<History*> history,
+		QVector<MTPint> ids,
+		bool revoke,
+		bool deletedBefore) {
+	// Server accepts a limited amount of ids in one request,
+	// the next chunk is sent only when the previous one is finished.
+	const auto rest = (ids.size() > kDeleteMessagesPerRequest)
+		? ids.mid(kDeleteMessagesPerRequest)
+		: QVector<MTPint>();
+	if (!rest.isEmpty()) {
+		ids.resize(kDeleteMessagesPerRequest);
+	}
 	sendRequest(history, RequestType::Delete, [=](Fn<void()> finish) {
+		const auto next = [=](bool deleted) {
+			finish();
+			if (!rest.isEmpty()) {
+				deleteMessagesChunk(
+					history,
+					rest,
+					revoke,
+					deletedBefore || deleted);
+			} else if (deletedBefore || deleted) {
+				history->requestChatListMessage();
+			}
+		};
 		const auto done = [=](const MTPmessages_AffectedMessages &result) {
 			session().api().applyAffectedMessages(history->peer, result);
-			finish();
-			history->requestChatListMessage();
+			next(true);
+		};
+		const auto fail = [=] {
+			next(false);
 		};
 		if (const auto channel = history->peer->asChannel()) {
 			return session().api().request(MTPchannels_DeleteMessages(
 				channel->inputChannel,
 				MTP_vector<MTPint>(ids)
-			)).done(done).fail(finish).send();
+			)).done(done).fail(fail).send();
 		} else {
 			using Flag = MTPmessages_DeleteMessages::Flag;
 			return session().api().request(MTPmessages_DeleteMessages(
 				MTP_flags(revoke ? Flag::f_revoke : Flag(0)),
 				MTP_vector<MTPint>(ids)
-			)).done(done).fail(finish).send();
+			)).done(done).fail(fail).send();
 		}
 	});
 }
@@ -783,6 +939,7 @@ void Histories::deleteMessages(const MessageIdsList &ids, bool revoke) {
 		}).send();
 	}
 
+	auto requestChatList = base::flat_set<not_null<History*>>();
 	for (const auto item : remove) {
 		const auto history = item->history();
 		const auto wasLast = (history->lastMessage() == item);
@@ -790,9 +947,12 @@ void Histories::deleteMessages(const MessageIdsList &ids, bool revoke) {
 		item->destroy();
 
 		if (wasLast || wasInChats) {
-			history->requestChatListMessage();
+			requestChatList.emplace(history);
 		}
 	}
+	for (const auto history : requestChatList) {
+		history->requestChatListMessage();
+	}
 }
 
 int Histories::sendRequest(
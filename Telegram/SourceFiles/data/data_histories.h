@@ -44,6 +44,9 @@ public:
 	void unloadAll();
 	void clearAll();
 
+	// Closed chats keep their views until there are too many of them.
+	void setOpened(not_null<History*> history, bool opened);
+
 	void readInbox(not_null<History*> history);
 	void readInboxTill(not_null<HistoryItem*> item);
 	void readInboxTill(not_null<History*> history, MsgId tillId);
@@ -59,6 +62,9 @@ public:
 	void changeDialogUnreadMark(not_null<History*> history, bool unread);
 	void requestFakeChatListMessage(not_null<History*> history);
 
+	// Loads the last page of the top chats, so they open without waiting.
+	void preloadTopHistories();
+
 	void requestGroupAround(not_null<HistoryItem*> item);
 
 	void deleteMessages(
@@ -117,8 +123,16 @@ private:
 	void sendReadRequests();
 	void sendReadRequest(not_null<History*> history, State &state);
 	[[nodiscard]] State *lookup(not_null<History*> history);
+	void applyPreloaded(
+		not_null<History*> history,
+		const MTPmessages_Messages &result);
 	void checkEmptyState(not_null<History*> history);
 	void checkPostponed(not_null<History*> history, int id);
+	void deleteMessagesChunk(
+		not_null<History*> history,
+		QVector<MTPint> ids,
+		bool revoke,
+		bool deletedBefore);
 	void finishSentRequest(
 		not_null<History*> history,
 		not_null<State*> state,
@@ -129,6 +143,8 @@ private:
 
 	void sendDialogRequests();
 
+	void checkUnloadClosed();
+
 	const not_null<Session*> _owner;
 
 	std::unordered_map<PeerId, std::unique_ptr<History>> _map;
@@ -146,6 +162,11 @@ private:
 		std::vector<Fn<void()>>> _dialogRequestsPending;
 
 	base::flat_set<not_null<History*>> _fakeChatListRequests;
+	base::flat_set<not_null<History*>> _preloadRequests;
+
+	base::flat_set<not_null<History*>> _opened;
+	base::flat_map<not_null<History*>, crl::time> _closedAt;
+	base::Timer _unloadClosedTimer;
 
 	base::flat_map<
 		not_null<History*>,
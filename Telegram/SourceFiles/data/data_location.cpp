@@ -13,6 +13,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Data {
 namespace {
 
+constexpr auto kQuantizeStep = 0.0001;
+
 [[nodiscard]] QString AsString(float64 value) {
 	constexpr auto kPrecision = 6;
 	return QString::number(value, 'f', kPrecision);
@@ -61,6 +63,16 @@ size_t LocationPoint::hash() const {
 		_lon);
 }
 
+LocationPoint LocationPoint::quantized() const {
+	const auto quantize = [](float64 value) {
+		return std::round(value / kQuantizeStep) * kQuantizeStep;
+	};
+	auto result = *this;
+	result._lat = quantize(_lat);
+	result._lon = quantize(_lon);
+	return result;
+}
+
 GeoPointLocation ComputeLocation(const LocationPoint &point) {
 	const auto scale = 1 + (cScale() * cIntRetinaFactor()) / 200;
 	const auto zoom = 13 + (scale - 1);
@@ -26,6 +26,10 @@ public:
 
 	[[nodiscard]] size_t hash() const;
 
+	// Points closer than a static map pixel share the same map image,
+	// the marker is painted above it on the client side anyway.
+	[[nodiscard]] LocationPoint quantized() const;
+
 private:
 	friend inline bool operator==(
 			const LocationPoint &a,
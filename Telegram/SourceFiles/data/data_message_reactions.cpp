@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "data/data_message_reactions.h"
 
+#include "core/application.h"
 #include "history/history.h"
 #include "history/history_item.h"
 #include "main/main_session.h"
@@ -28,8 +29,15 @@ namespace {
 
 constexpr auto kRefreshFullListEach = 60 * 60 * crl::time(1000);
 constexpr auto kPollEach = 20 * crl::time(1000);
+constexpr auto kPollEachInactive = 60 * crl::time(1000);
 constexpr auto kSizeForDownscale = 64;
 
+[[nodiscard]] crl::time PollGroupedTime(not_null<HistoryItem*> item) {
+	// Group them by one second.
+	const auto last = item->lastReactionsRefreshTime();
+	return ((last + 999) / 1000) * 1000;
+}
+
 } // namespace
 
 Reactions::Reactions(not_null<Session*> owner)
@@ -52,6 +60,20 @@ Reactions::Reactions(not_null<Session*> owner)
 		_repaintItems.remove(item);
 	}, _lifetime);
 
+	Core::App().appDeactivatedValue(
+	) | rpl::filter([](bool deactivated) {
+		return !deactivated;
+	}) | rpl::start_with_next([=] {
+		// Items scheduled while inactive wait for kPollEachInactive.
+		if (_repaintItems.empty()) {
+			return;
+		}
+		for (auto &[item, when] : _repaintItems) {
+			when = std::min(when, PollGroupedTime(item) + kPollEach);
+		}
+		repaintCollected();
+	}, _lifetime);
+
 	const auto appConfig = &_owner->session().account().appConfig();
 	appConfig->value(
 	) | rpl::start_with_next([=] {
@@ -385,15 +407,16 @@ void Reactions::send(not_null<HistoryItem*> item, const QString &chosen) {
 }
 
 void Reactions::poll(not_null<HistoryItem*> item, crl::time now) {
-	// Group them by one second.
-	const auto last = item->lastReactionsRefreshTime();
-	const auto grouped = ((last + 999) / 1000) * 1000;
+	const auto grouped = PollGroupedTime(item);
+	const auto each = Core::App().hasActiveWindow(&_owner->session())
+		? kPollEach
+		: kPollEachInactive;
 	if (!grouped || item->history()->peer->isUser()) {
 		// First reaction always edits message.
 		return;
-	} else if (const auto left = grouped + kPollEach - now; left > 0) {
+	} else if (const auto left = grouped + each - now; left > 0) {
 		if (!_repaintItems.contains(item)) {
-			_repaintItems.emplace(item, grouped + kPollEach);
+			_repaintItems.emplace(item, grouped + each);
 			if (!_repaintTimer.isActive()
 				|| _repaintTimer.remainingTime() > left) {
 				_repaintTimer.callOnce(left);
@@ -441,8 +464,12 @@ void Reactions::pollCollected() {
 		toRequest[item->history()->peer].push_back(MTP_int(item->id));
 	}
 	auto &api = _owner->session().api();
+	const auto waiting = std::make_shared<int>(toRequest.size());
 	for (const auto &[peer, ids] : toRequest) {
 		const auto finalize = [=] {
+			if (--*waiting > 0) {
+				return;
+			}
 			const auto now = crl::now();
 			for (const auto &item : base::take(_pollingItems)) {
 				const auto last = item->lastReactionsRefreshTime();
@@ -0,0 +1,109 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_messages_index.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kRecentMinLimit = 64;
+
+template <typename Entries>
+[[nodiscard]] auto FindEntry(Entries &entries, MsgId id) {
+	const auto i = ranges::lower_bound(
+		entries,
+		id,
+		ranges::less(),
+		&std::pair<MsgId, HistoryItem*>::first);
+	return (i != end(entries) && i->first == id) ? i : end(entries);
+}
+
+} // namespace
+
+HistoryItem *MessagesIndex::lookup(MsgId id) const {
+	if (const auto i = FindEntry(_main, id); i != end(_main)) {
+		return i->second;
+	} else if (const auto j = FindEntry(_recent, id); j != end(_recent)) {
+		return j->second;
+	}
+	return nullptr;
+}
+
+bool MessagesIndex::add(MsgId id, not_null<HistoryItem*> item) {
+	if (const auto i = FindEntry(_main, id); i != end(_main)) {
+		if (i->second) {
+			return false;
+		}
+		i->second = item;
+		--_removed;
+		return true;
+	} else if (FindEntry(_recent, id) != end(_recent)) {
+		return false;
+	}
+	const auto after = [&](const std::vector<Entry> &entries) {
+		return entries.empty() || (entries.back().first < id);
+	};
+	if (after(_main) && after(_recent)) {
+		_main.emplace_back(id, item.get());
+		return true;
+	}
+	const auto i = ranges::lower_bound(
+		_recent,
+		id,
+		ranges::less(),
+		&Entry::first);
+	_recent.emplace(i, id, item.get());
+	const auto size = int(_recent.size());
+	if (size > kRecentMinLimit && size * size > int(_main.size())) {
+		merge();
+	}
+	return true;
+}
+
+bool MessagesIndex::remove(MsgId id) {
+	if (const auto i = FindEntry(_recent, id); i != end(_recent)) {
+		_recent.erase(i);
+		return true;
+	}
+	const auto i = FindEntry(_main, id);
+	if (i == end(_main) || !i->second) {
+		return false;
+	}
+	i->second = nullptr;
+	if (++_removed * 2 > int(_main.size())) {
+		compact();
+	}
+	return true;
+}
+
+void MessagesIndex::merge() {
+	auto result = std::vector<Entry>();
+	result.reserve(_main.size() - _removed + _recent.size());
+	auto i = begin(_recent);
+	for (const auto &entry : _main) {
+		if (!entry.second) {
+			continue;
+		}
+		for (; i != end(_recent) && i->first < entry.first; ++i) {
+			result.push_back(*i);
+		}
+		result.push_back(entry);
+	}
+	result.insert(end(result), i, end(_recent));
+	_main = std::move(result);
+	_recent.clear();
+	_removed = 0;
+}
+
+void MessagesIndex::compact() {
+	_main.erase(
+		ranges::remove(_main, nullptr, &Entry::second),
+		end(_main));
+	_removed = 0;
+}
+
+} // namespace Data
@@ -0,0 +1,43 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+class HistoryItem;
+
+namespace Data {
+
+// Sorted contiguous index of the loaded messages of one peer.
+//
+// New messages with the largest id are appended to the main array.
+// Other insertions (older slices, local ids) go to a small sorted array
+// that is merged into the main one once it grows beyond its square root.
+// Removals only mark the entry and the main array is compacted once half
+// of it is removed, so bulk loads and clears don't move the whole array
+// for each message.
+class MessagesIndex final {
+public:
+	[[nodiscard]] HistoryItem *lookup(MsgId id) const;
+
+	// Returns false if a message with that id is already there.
+	bool add(MsgId id, not_null<HistoryItem*> item);
+	bool remove(MsgId id);
+
+private:
+	// Removed entries keep their id and have a nullptr item.
+	using Entry = std::pair<MsgId, HistoryItem*>;
+
+	void merge();
+	void compact();
+
+	std::vector<Entry> _main;
+	std::vector<Entry> _recent;
+	int _removed = 0;
+
+};
+
+} // namespace Data
@@ -74,8 +74,9 @@ void PhotoData::automaticLoadSettingsChanged() {
 void PhotoData::load(
 		Data::FileOrigin origin,
 		LoadFromCloudSetting fromCloud,
-		bool autoLoading) {
-	load(PhotoSize::Large, origin, fromCloud, autoLoading);
+		bool autoLoading,
+		bool lowPriority) {
+	load(PhotoSize::Large, origin, fromCloud, autoLoading, lowPriority);
 }
 
 bool PhotoData::loading() const {
@@ -284,10 +285,18 @@ void PhotoData::load(
 		PhotoSize size,
 		Data::FileOrigin origin,
 		LoadFromCloudSetting fromCloud,
-		bool autoLoading) {
+		bool autoLoading,
+		bool lowPriority) {
 	const auto valid = validSizeIndex(size);
 	const auto existing = existingSizeIndex(size);
 
+	auto &file = _images[valid];
+	if (lowPriority && !file.loader) {
+		file.flags |= Data::CloudFile::Flag::LowPriority;
+	} else if (!lowPriority) {
+		file.flags &= ~Data::CloudFile::Flag::LowPriority;
+	}
+
 	// Could've changed, if the requested size didn't have a location.
 	const auto validSize = static_cast<PhotoSize>(valid);
 	const auto finalCheck = [=] {
@@ -108,7 +108,8 @@ public:
 	void load(
 		Data::FileOrigin origin,
 		LoadFromCloudSetting fromCloud = LoadFromCloudOrLocal,
-		bool autoLoading = false);
+		bool autoLoading = false,
+		bool lowPriority = false);
 
 	[[nodiscard]] static int SideLimit();
 
@@ -120,7 +121,8 @@ public:
 		Data::PhotoSize size,
 		Data::FileOrigin origin,
 		LoadFromCloudSetting fromCloud = LoadFromCloudOrLocal,
-		bool autoLoading = false);
+		bool autoLoading = false,
+		bool lowPriority = false);
 	[[nodiscard]] const ImageLocation &location(Data::PhotoSize size) const;
 	[[nodiscard]] std::optional<QSize> size(Data::PhotoSize size) const;
 	[[nodiscard]] int imageByteSize(Data::PhotoSize size) const;
@@ -173,6 +173,7 @@ void PhotoMedia::automaticLoad(
 	_owner->load(
 		origin,
 		loadFromCloud ? LoadFromCloudOrLocal : LoadFromLocalOnly,
+		true,
 		true);
 }
 
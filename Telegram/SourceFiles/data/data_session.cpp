@@ -28,6 +28,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/media/history_view_media.h"
 #include "history/view/history_view_element.h"
 #include "inline_bots/inline_bot_layout_item.h"
+#include "storage/download_manager_mtproto.h"
 #include "storage/storage_account.h"
 #include "storage/storage_encrypted_file.h"
 #include "media/player/media_player_instance.h" // instance()->play()
@@ -1023,6 +1024,7 @@ void Session::chatsListDone(Data::Folder *folder) {
 		folder->chatsList()->setLoaded();
 	} else {
 		_chatsList.setLoaded();
+		histories().preloadTopHistories();
 	}
 	_chatsListLoadedEvents.fire_copy(folder);
 }
@@ -1352,11 +1354,10 @@ rpl::producer<not_null<HistoryItem*>> Session::newItemAdded() const {
 
 void Session::changeMessageId(PeerId peerId, MsgId wasId, MsgId nowId) {
 	const auto list = messagesListForInsert(peerId);
-	auto i = list->find(wasId);
-	Assert(i != list->end());
-	const auto item = i->second;
-	list->erase(i);
-	const auto [j, ok] = list->emplace(nowId, item);
+	const auto item = list->lookup(wasId);
+	Assert(item != nullptr);
+	list->remove(wasId);
+	const auto ok = list->add(nowId, item);
 
 	if (!peerIsChannel(peerId)) {
 		if (IsServerMsgId(wasId)) {
@@ -1911,7 +1912,8 @@ void Session::updateEditedMessage(const MTPMessage &data) {
 void Session::processMessages(
 		const QVector<MTPMessage> &data,
 		NewMessageType type) {
-	auto indices = base::flat_map<uint64, int>();
+	auto indices = std::vector<std::pair<uint64, int>>();
+	indices.reserve(data.size());
 	for (int i = 0, l = data.size(); i != l; ++i) {
 		const auto &message = data[i];
 		if (message.type() == mtpc_message) {
@@ -1923,8 +1925,9 @@ void Session::processMessages(
 			}
 		}
 		const auto id = IdFromMessage(message); // Only 32 bit values here.
-		indices.emplace((uint64(uint32(id.bare)) << 32) | uint64(i), i);
+		indices.emplace_back((uint64(uint32(id.bare)) << 32) | uint64(i), i);
 	}
+	ranges::sort(indices);
 	for (const auto &[position, index] : indices) {
 		addNewMessage(
 			data[index],
@@ -1973,12 +1976,11 @@ void Session::registerMessage(not_null<HistoryItem*> item) {
 	const auto peerId = item->history()->peer->id;
 	const auto list = messagesListForInsert(peerId);
 	const auto itemId = item->id;
-	const auto i = list->find(itemId);
-	if (i != list->end()) {
+	if (const auto existing = list->lookup(itemId)) {
 		LOG(("App Error: Trying to re-registerMessage()."));
-		i->second->destroy();
+		existing->destroy();
 	}
-	list->emplace(itemId, item);
+	list->add(itemId, item);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.emplace(itemId, item);
@@ -2047,10 +2049,9 @@ void Session::processMessagesDeleted(
 
 	auto historiesToCheck = base::flat_set<not_null<History*>>();
 	for (const auto &messageId : data) {
-		const auto i = list ? list->find(messageId.v) : Messages::iterator();
-		if (list && i != list->end()) {
-			const auto history = i->second->history();
-			i->second->destroy();
+		if (const auto item = list ? list->lookup(messageId.v) : nullptr) {
+			const auto history = item->history();
+			item->destroy();
 			if (!history->chatListMessageKnown()) {
 				historiesToCheck.emplace(history);
 			}
@@ -2102,7 +2103,7 @@ void Session::unregisterMessage(not_null<HistoryItem*> item) {
 		Data::MessageUpdate::Flag::Destroyed);
 	groups().unregisterMessage(item);
 	removeDependencyMessage(item);
-	messagesListForInsert(peerId)->erase(itemId);
+	messagesListForInsert(peerId)->remove(itemId);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.erase(itemId);
@@ -2139,8 +2140,7 @@ HistoryItem *Session::message(PeerId peerId, MsgId itemId) const {
 		return nullptr;
 	}
 
-	const auto i = data->find(itemId);
-	return (i != data->end()) ? i->second.get() : nullptr;
+	return data->lookup(itemId);
 }
 
 HistoryItem *Session::message(
@@ -2620,6 +2620,7 @@ void Session::photoApplyFields(
 		return;
 	}
 	photo->setRemoteLocation(dc, access, fileReference);
+	_session->downloader().prepareDc(dc);
 	photo->date = date;
 	photo->setHasAttachedStickers(hasStickers);
 	photo->updateImages(
@@ -2858,6 +2859,7 @@ void Session::documentApplyFields(
 	document->recountIsImage();
 	if (dc != 0 && access != 0) {
 		document->setRemoteLocation(dc, access, fileReference);
+		_session->downloader().prepareDc(dc);
 	}
 }
 
@@ -3276,7 +3278,10 @@ void Session::applyUpdate(const MTPDupdateChatDefaultBannedRights &update) {
 	}
 }
 
-not_null<Data::CloudImage*> Session::location(const LocationPoint &point) {
+not_null<Data::CloudImage*> Session::location(
+		const LocationPoint &original) {
+	// Live location updates and near-identical venues reuse one map.
+	const auto point = original.quantized();
 	const auto i = _locations.find(point);
 	if (i != _locations.cend()) {
 		return i->second.get();
@@ -3717,11 +3722,12 @@ void Session::refreshChatListEntry(Dialogs::Key key) {
 	if (!history) {
 		return;
 	}
+	const auto state = Data::ChatFilter::ComputeState(history);
 	for (const auto &filter : _chatsFilters->list()) {
 		const auto id = filter.id();
 		const auto filterList = chatsFilters().chatsList(id);
 		auto event = ChatListEntryRefresh{ .key = key, .filterId = id };
-		if (filter.contains(history)) {
+		if (filter.contains(history, state)) {
 			event.existenceChanged = !entry->inChatList(id);
 			if (event.existenceChanged) {
 				entry->addToChatList(id, filterList);
@@ -65,7 +65,7 @@ UserPhotosSlice::UserPhotosSlice(
 	std::optional<int> skippedBefore,
 	std::optional<int> skippedAfter)
 : AbstractSparseIds<std::deque<PhotoId>>(
-	ids,
+	std::move(ids),
 	fullCount,
 	skippedBefore,
 	skippedAfter)
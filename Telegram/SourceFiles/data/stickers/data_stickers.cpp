@@ -286,7 +286,7 @@ void Stickers::applyArchivedResult(
 		}
 		if (setData) {
 			auto set = feedSet(*setData);
-			if (set->stickers.isEmpty()) {
+			if (set->stickers.isEmpty() && set->localStickers.isEmpty()) {
 				setsToRequest.insert(set->id, set->accessHash);
 			}
 			const auto masks = !!(set->flags & SetFlag::Masks);
@@ -604,7 +604,7 @@ void Stickers::setsOrMasksReceived(
 		if (!(set->flags & SetFlag::Archived)
 			|| (set->flags & SetFlag::Official)) {
 			setsOrder.push_back(set->id);
-			if (set->stickers.isEmpty()
+			if ((set->stickers.isEmpty() && set->localStickers.isEmpty())
 				|| (set->flags & SetFlag::NotLoaded)) {
 				setsToRequest.insert(set->id, set->accessHash);
 			}
@@ -890,15 +890,21 @@ void Stickers::featuredSetsReceived(
 				| (set->flags & (SetFlag::NotLoaded | SetFlag::Special));
 			set->installDate = installDate;
 			set->setThumbnail(thumbnail);
-			if (set->count != data->vcount().v || set->hash != data->vhash().v || set->emoji.isEmpty()) {
+			// Emoji of lazily read sets are in localStickers as well.
+			const auto noEmoji = set->emoji.isEmpty()
+				&& set->localStickers.isEmpty();
+			if (set->count != data->vcount().v
+				|| set->hash != data->vhash().v
+				|| noEmoji) {
 				set->count = data->vcount().v;
 				set->hash = data->vhash().v;
 				set->flags |= SetFlag::NotLoaded; // need to request this set
 			}
 		}
 		setsOrder.push_back(data->vid().v);
-		if (it->second->stickers.isEmpty()
-			|| (it->second->flags & SetFlag::NotLoaded)) {
+		const auto set = it->second.get();
+		if ((set->stickers.isEmpty() && set->localStickers.isEmpty())
+			|| (set->flags & SetFlag::NotLoaded)) {
 			setsToRequest.emplace(data->vid().v, data->vaccess_hash().v);
 		}
 	}
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_session.h"
 #include "data/data_file_origin.h"
 #include "storage/file_download.h"
+#include "storage/storage_account.h"
 #include "ui/image/image.h"
 
 namespace Data {
@@ -82,6 +83,12 @@ Main::Session &StickersSet::session() const {
 	return _owner->session();
 }
 
+void StickersSet::materializeLocalStickers() {
+	if (!localStickers.isEmpty()) {
+		session().local().materializeStickerSet(this);
+	}
+}
+
 MTPInputStickerSet StickersSet::mtpInput() const {
 	return (id && accessHash)
 		? MTP_inputStickerSetID(MTP_long(id), MTP_long(accessHash))
@@ -94,6 +94,9 @@ public:
 	[[nodiscard]] std::shared_ptr<StickersSetThumbnailView> createThumbnailView();
 	[[nodiscard]] std::shared_ptr<StickersSetThumbnailView> activeThumbnailView();
 
+	// Reads the stickers postponed while reading the sets from local storage.
+	void materializeLocalStickers();
+
 	uint64 id = 0;
 	uint64 accessHash = 0;
 	uint64 hash = 0;
@@ -106,6 +109,10 @@ public:
 	std::vector<TimeId> dates;
 	StickersByEmojiMap emoji;
 
+	QByteArray localStickers;
+	int localStickersVersion = 0;
+	int localStickersCount = 0;
+
 private:
 	const not_null<Data::Session*> _owner;
 
@@ -49,6 +49,11 @@ public:
 	}
 	std::vector<not_null<Row*>> filtered(const QStringList &words) const;
 
+	// Each of the words is a prefix of one of the row name words.
+	[[nodiscard]] static bool Matches(
+		not_null<Row*> row,
+		const QStringList &words);
+
 	// Part of List interface is duplicated here for all() list.
 	int size() const { return all().size(); }
 	bool empty() const { return all().empty(); }
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_search_from_controllers.h"
 #include "history/history.h"
 #include "history/history_item.h"
+#include "history/view/history_view_paint_stats.h"
 #include "core/shortcuts.h"
 #include "core/application.h"
 #include "ui/widgets/buttons.h"
@@ -62,6 +63,8 @@ namespace {
 
 constexpr auto kHashtagResultsLimit = 5;
 constexpr auto kStartReorderThreshold = 30;
+constexpr auto kPreloadSelectedDelay = crl::time(300);
+constexpr auto kPreloadSelectedMessages = 50;
 
 int FixedOnTopDialogsCount(not_null<Dialogs::IndexedList*> list) {
 	auto result = 0;
@@ -122,7 +125,8 @@ InnerWidget::InnerWidget(
 	return pinnedShiftAnimationCallback(now);
 })
 , _cancelSearchInChat(this, st::dialogsCancelSearchInPeer)
-, _cancelSearchFromUser(this, st::dialogsCancelSearchInPeer) {
+, _cancelSearchFromUser(this, st::dialogsCancelSearchInPeer)
+, _preloadTimer([=] { preloadSelected(); }) {
 	setAttribute(Qt::WA_OpaquePaintEvent, true);
 
 	_cancelSearchInChat->hide();
@@ -214,19 +218,43 @@ InnerWidget::InnerWidget(
 	}, lifetime());
 
 	using UpdateFlag = Data::PeerUpdate::Flag;
-	session().changes().peerUpdates(
-		UpdateFlag::Name
-		| UpdateFlag::Photo
-		| UpdateFlag::IsContact
-	) | rpl::start_with_next([=](const Data::PeerUpdate &update) {
-		if (update.flags & (UpdateFlag::Name | UpdateFlag::Photo)) {
+	session().changes().peerUpdatesBatched(
+		UpdateFlag::Name | UpdateFlag::Photo
+	) | rpl::start_with_next([=](const std::vector<Data::PeerUpdate> &list) {
+		// Names are painted in other rows previews as well,
+		// while a new photo changes only the chats list row of its peer
+		// and the row of its folder, that shows the top chats userpics.
+		const auto full = (_state != WidgetState::Default)
+			|| ranges::any_of(list, [&](const Data::PeerUpdate &update) {
+				return (update.flags & UpdateFlag::Name);
+			});
+		if (full) {
 			this->update();
-			_updated.fire({});
-		}
-		if (update.flags & UpdateFlag::IsContact) {
-			// contactsNoChatsList could've changed.
-			Ui::PostponeCall(this, [=] { refresh(); });
+		} else {
+			for (const auto &update : list) {
+				if (const auto history = session().data().historyLoaded(
+						update.peer)) {
+					updateDialogRow(
+						RowDescriptor(history, FullMsgId()),
+						QRect(),
+						UpdateRowSection::Default);
+					if (const auto folder = history->folder()) {
+						updateDialogRow(
+							RowDescriptor(folder, FullMsgId()),
+							QRect(),
+							UpdateRowSection::Default);
+					}
+				}
+			}
 		}
+		_updated.fire({});
+	}, lifetime());
+
+	session().changes().peerUpdates(
+		UpdateFlag::IsContact
+	) | rpl::start_with_next([=] {
+		// contactsNoChatsList could've changed.
+		Ui::PostponeCall(this, [=] { refresh(); });
 	}, lifetime());
 
 	session().changes().messageUpdates(
@@ -235,6 +263,23 @@ InnerWidget::InnerWidget(
 		refreshDialogRow({ update.item->history(), update.item->fullId() });
 	}, lifetime());
 
+	// Rows that were added or renamed after the last full filter
+	// could match the next query without being in the current results.
+	using EntryRefresh = Data::Session::ChatListEntryRefresh;
+	rpl::merge(
+		session().data().chatsListChanges() | rpl::to_empty,
+		session().data().chatsListLoadedEvents() | rpl::to_empty,
+		session().data().chatListEntryRefreshes(
+		) | rpl::filter([](const EntryRefresh &event) {
+			return event.existenceChanged;
+		}) | rpl::to_empty,
+		session().changes().peerUpdates(
+			UpdateFlag::Name | UpdateFlag::IsContact
+		) | rpl::to_empty
+	) | rpl::start_with_next([=] {
+		_filterResultsOutdated = true;
+	}, lifetime());
+
 	session().changes().entryUpdates(
 		Data::EntryUpdate::Flag::Repaint
 	) | rpl::start_with_next([=](const Data::EntryUpdate &update) {
@@ -258,6 +303,10 @@ InnerWidget::InnerWidget(
 			RowDescriptor next) {
 		updateDialogRow(previous);
 		updateDialogRow(next);
+		if (next.key.history() == _preloadHistory) {
+			// The section loads the chat by itself now.
+			cancelPreload();
+		}
 	}, lifetime());
 
 	_controller->activeChatsFilter(
@@ -381,6 +430,7 @@ void InnerWidget::changeOpenedFolder(Data::Folder *folder) {
 }
 
 void InnerWidget::paintEvent(QPaintEvent *e) {
+	const auto frameGuard = HistoryView::FramePaintGuard(u"dialogs"_q);
 	Painter p(this);
 
 	const auto r = e->rect();
@@ -940,6 +990,7 @@ void InnerWidget::selectByMouse(QPoint globalPosition) {
 			setCursor((_selected || _collapsedSelected)
 				? style::cur_pointer
 				: style::cur_default);
+			schedulePreloadSelected();
 		}
 	} else if (_state == WidgetState::Filtered) {
 		auto wasSelected = isSelected();
@@ -1817,14 +1868,45 @@ void InnerWidget::applyFilterUpdate(QString newFilter, bool force) {
 		: TextUtilities::PrepareSearchWords(newFilter);
 	newFilter = words.isEmpty() ? QString() : words.join(' ');
 	if (newFilter != _filter || force) {
+		const auto narrowed = !force
+			&& !mentionsSearch
+			&& !_searchInChat
+			&& (_state == WidgetState::Filtered)
+			&& !_filterResultsOutdated
+			&& !_filter.isEmpty()
+			&& ranges::all_of(_filter.split(' '), [&](const QString &was) {
+				return ranges::any_of(words, [&](const QString &word) {
+					return word.startsWith(was);
+				});
+			});
 		_filter = newFilter;
 		if (_filter.isEmpty() && !_searchFromPeer) {
 			clearFilter();
+		} else if (narrowed) {
+			// Each old word is a prefix of a new one,
+			// so only the rows already found can match.
+			_waitingForSearch = true;
+			const auto global = [&](not_null<Row*> row) {
+				const auto history = row->history();
+				const auto i = history
+					? _filterResultsGlobal.find(history->peer)
+					: end(_filterResultsGlobal);
+				return (i != end(_filterResultsGlobal))
+					&& (i->second.get() == row);
+			};
+			_filterResults.erase(
+				ranges::remove_if(_filterResults, [&](not_null<Row*> row) {
+					return global(row) || !IndexedList::Matches(row, words);
+				}),
+				end(_filterResults));
+			_filterResultsGlobal.clear();
+			refresh(true);
 		} else {
 			_state = WidgetState::Filtered;
 			_waitingForSearch = true;
 			_filterResults.clear();
 			_filterResultsGlobal.clear();
+			_filterResultsOutdated = false;
 			const auto append = [&](not_null<IndexedList*> list) {
 				const auto results = list->filtered(words);
 				_filterResults.insert(
@@ -1880,6 +1962,7 @@ void InnerWidget::onHashtagFilterUpdate(QStringView newFilter) {
 }
 
 InnerWidget::~InnerWidget() {
+	cancelPreload();
 	clearSearchResults();
 }
 
@@ -2106,6 +2189,21 @@ bool InnerWidget::searchReceived(
 	return lastDateFound != 0;
 }
 
+void InnerWidget::localSearchReceived(
+		const std::vector<not_null<HistoryItem*>> &found) {
+	if (_state != WidgetState::Filtered || !_searchInChat) {
+		return;
+	}
+	// Server results for the same query will replace these.
+	clearSearchResults(false);
+	for (const auto &item : found) {
+		_searchResults.push_back(
+			std::make_unique<FakeRow>(_searchInChat, item));
+	}
+	_searchedCount = int(found.size());
+	refresh();
+}
+
 void InnerWidget::peerSearchReceived(
 		const QString &query,
 		const QVector<MTPPeer> &my,
@@ -2441,6 +2539,7 @@ void InnerWidget::selectSkip(int32 direction) {
 				: (dialogsOffset() + _selected->pos() * st::dialogsRowHeight);
 			_mustScrollTo.fire({ fromY, fromY + st::dialogsRowHeight });
 		}
+		schedulePreloadSelected();
 	} else if (_state == WidgetState::Filtered) {
 		if (_hashtagResults.empty() && _filterResults.empty() && _peerSearchResults.empty() && _searchResults.empty()) {
 			return;
@@ -2578,12 +2677,85 @@ void InnerWidget::selectSkipPage(int32 pixels, int32 direction) {
 				: (dialogsOffset() + _selected->pos() * st::dialogsRowHeight);
 			_mustScrollTo.fire({ fromY, fromY + st::dialogsRowHeight });
 		}
+		schedulePreloadSelected();
 	} else {
 		return selectSkip(direction * toSkip);
 	}
 	update();
 }
 
+void InnerWidget::schedulePreloadSelected() {
+	_preloadTimer.callOnce(kPreloadSelectedDelay);
+}
+
+void InnerWidget::preloadSelected() {
+	const auto history = (_state == WidgetState::Default && _selected)
+		? _selected->history()
+		: nullptr;
+	if (!history || history == _preloadHistory) {
+		return;
+	}
+	cancelPreload();
+	if (!history->isEmpty()
+		|| _controller->activeChatEntryCurrent().key.history() == history) {
+		return;
+	}
+	_preloadHistory = history;
+
+	// Warm up the chat header as well, not only the messages.
+	history->peer->loadUserpic();
+
+	const auto around = history->loadAroundId();
+	const auto count = kPreloadSelectedMessages;
+	const auto type = Data::Histories::RequestType::History;
+	auto &histories = history->owner().histories();
+	_preloadRequestId = histories.sendRequest(history, type, [=](
+			Fn<void()> finish) {
+		return session().api().request(MTPmessages_GetHistory(
+			history->peer->input,
+			MTP_int(around),
+			MTP_int(0), // offset_date
+			MTP_int(around ? (-count / 2) : 0),
+			MTP_int(count),
+			MTP_int(0), // max_id
+			MTP_int(0), // min_id
+			MTP_long(0) // hash
+		)).done([=](const MTPmessages_Messages &result) {
+			if (_preloadHistory == history) {
+				_preloadHistory = nullptr;
+				_preloadRequestId = 0;
+			}
+			// Only fill the history if nobody else loaded something there,
+			// the chat could've been opened in another window or section.
+			if (history->isEmpty() && history->loadAroundId() == around) {
+				history->getReadyFor(around
+					? ShowAtUnreadMsgId
+					: ShowAtTheEndMsgId);
+				result.match([](const MTPDmessages_messagesNotModified &) {
+				}, [&](const auto &data) {
+					history->owner().processUsers(data.vusers());
+					history->owner().processChats(data.vchats());
+					history->addOlderSlice(data.vmessages().v);
+				});
+			}
+			finish();
+		}).fail([=] {
+			if (_preloadHistory == history) {
+				_preloadHistory = nullptr;
+				_preloadRequestId = 0;
+			}
+			finish();
+		}).send();
+	});
+}
+
+void InnerWidget::cancelPreload() {
+	if (const auto history = base::take(_preloadHistory)) {
+		history->owner().histories().cancelRequest(
+			base::take(_preloadRequestId));
+	}
+}
+
 void InnerWidget::loadPeerPhotos() {
 	if (!parentWidget()) return;
 
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/effects/animations.h"
 #include "ui/rp_widget.h"
 #include "base/flags.h"
+#include "base/timer.h"
 #include "base/object_ptr.h"
 
 namespace MTP {
@@ -77,6 +78,8 @@ public:
 		HistoryItem *inject,
 		SearchRequestType type,
 		int fullCount);
+	void localSearchReceived(
+		const std::vector<not_null<HistoryItem*>> &found);
 	void peerSearchReceived(
 		const QString &query,
 		const QVector<MTPPeer> &my,
@@ -314,6 +317,9 @@ private:
 
 	void clearSearchResults(bool clearPeerSearchResults = true);
 	void updateSelectedRow(Key key = Key());
+	void schedulePreloadSelected();
+	void preloadSelected();
+	void cancelPreload();
 
 	not_null<IndexedList*> shownDialogs() const;
 
@@ -374,6 +380,7 @@ private:
 		std::unique_ptr<Row>> _filterResultsGlobal;
 	int _filteredSelected = -1;
 	int _filteredPressed = -1;
+	bool _filterResultsOutdated = false;
 
 	bool _waitingForSearch = false;
 	EmptyState _emptyState = EmptyState::None;
@@ -424,6 +431,10 @@ private:
 
 	base::unique_qptr<Ui::PopupMenu> _menu;
 
+	base::Timer _preloadTimer;
+	History *_preloadHistory = nullptr;
+	int _preloadRequestId = 0;
+
 };
 
 } // namespace Dialogs
@@ -12,6 +12,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_key.h"
 #include "dialogs/dialogs_entry.h"
 #include "history/history.h"
+#include "history/history_item.h"
+#include "history/view/history_view_element.h"
 #include "history/view/history_view_top_bar_widget.h"
 #include "ui/widgets/buttons.h"
 #include "ui/widgets/input_fields.h"
@@ -929,6 +931,9 @@ bool Widget::searchMessages(bool searchCache) {
 			auto &histories = session().data().histories();
 			const auto type = Data::Histories::RequestType::History;
 			const auto history = session().data().history(peer);
+			if (!_searchQueryFrom) {
+				showLocalSearchResults(history);
+			}
 			_searchInHistoryRequest = histories.sendRequest(history, type, [=](Fn<void()> finish) {
 				const auto type = SearchRequestType::PeerFromStart;
 				const auto flags = _searchQueryFrom
@@ -1192,6 +1197,32 @@ void Widget::searchMore() {
 	}
 }
 
+void Widget::showLocalSearchResults(not_null<History*> history) {
+	// Show the loaded messages that match while the server is searching.
+	auto found = std::vector<not_null<HistoryItem*>>();
+	const auto collect = [&] {
+		for (const auto &block : ranges::views::reverse(history->blocks)) {
+			for (const auto &view : ranges::views::reverse(block->messages)) {
+				const auto item = view->data();
+				if (!item->isRegular()
+					|| !item->originalText().text.contains(
+						_searchQuery,
+						Qt::CaseInsensitive)) {
+					continue;
+				}
+				found.push_back(item);
+				if (int(found.size()) == SearchPerPage) {
+					return;
+				}
+			}
+		}
+	};
+	collect();
+	if (!found.empty()) {
+		_inner->localSearchReceived(found);
+	}
+}
+
 void Widget::searchReceived(
 		SearchRequestType type,
 		const MTPmessages_Messages &result,
@@ -123,6 +123,7 @@ private:
 
 	bool searchMessages(bool searchCache = false);
 	void needSearchMessages();
+	void showLocalSearchResults(not_null<History*> history);
 
 	void animationCallback();
 	void searchReceived(
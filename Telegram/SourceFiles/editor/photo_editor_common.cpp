@@ -17,20 +17,35 @@ QImage ImageModified(QImage image, const PhotoModifications &mods) {
 	if (!mods) {
 		return image;
 	}
+	const auto crop = mods.crop.isValid()
+		? mods.crop.intersected(image.rect())
+		: image.rect();
+	auto cropped = (crop != image.rect()) ? image.copy(crop) : image;
 	if (mods.paint) {
-		if (image.format() != QImage::Format_ARGB32_Premultiplied) {
-			image = image.convertToFormat(
+		if (cropped.format() != QImage::Format_ARGB32_Premultiplied) {
+			cropped = cropped.convertToFormat(
 				QImage::Format_ARGB32_Premultiplied);
 		}
 
-		Painter p(&image);
+		// Render only the part of the scene that survives the crop.
+		const auto scene = mods.paint->sceneRect();
+		const auto scaleX = scene.width() / image.width();
+		const auto scaleY = scene.height() / image.height();
+		const auto source = QRectF(
+			scene.x() + crop.x() * scaleX,
+			scene.y() + crop.y() * scaleY,
+			crop.width() * scaleX,
+			crop.height() * scaleY);
+
+		Painter p(&cropped);
 		PainterHighQualityEnabler hq(p);
 
-		mods.paint->render(&p, image.rect());
+		mods.paint->render(
+			&p,
+			cropped.rect(),
+			source,
+			Qt::IgnoreAspectRatio);
 	}
-	auto cropped = mods.crop.isValid()
-		? image.copy(mods.crop)
-		: image;
 	QTransform transform;
 	if (mods.flipped) {
 		transform.scale(-1, 1);
@@ -21,58 +21,13 @@ QRectF NormalizedRect(const QPointF& p1, const QPointF& p2) {
 		std::abs(p2.y() - p1.y()) + 1);
 }
 
-std::vector<QPointF> InterpolatedPoints(
-		const QPointF &startPoint,
-		const QPointF &endPoint) {
-	std::vector<QPointF> points;
-
-	const auto x1 = startPoint.x();
-	const auto y1 = startPoint.y();
-	const auto x2 = endPoint.x();
-	const auto y2 = endPoint.y();
-
-	// Difference of x and y values.
-	const auto dx = x2 - x1;
-	const auto dy = y2 - y1;
-
-	// Absolute values of differences.
-	const auto ix = std::abs(dx);
-	const auto iy = std::abs(dy);
-
-	// Larger of the x and y differences.
-	const auto inc = ix > iy ? ix : iy;
-
-	// Plot location.
-	auto plotx = x1;
-	auto ploty = y1;
-
-	auto x = 0;
-	auto y = 0;
-
-	points.push_back(QPointF(plotx, ploty));
-
-	for (auto i = 0; i <= inc; i++) {
-		const auto xInc = x > inc;
-		const auto yInc = y > inc;
-
-		x += ix;
-		y += iy;
-
-		if (xInc) {
-			x -= inc;
-			plotx += 1 * ((dx < 0) ? -1 : 1);
-		}
-
-		if (yInc) {
-			y -= inc;
-			ploty += 1 * ((dy < 0) ? -1 : 1);
-		}
-
-		if (xInc || yInc) {
-			points.push_back(QPointF(plotx, ploty));
-		}
-	}
-	return points;
+QPen BrushPen(const QColor &color, float size) {
+	return QPen(
+		color,
+		size,
+		Qt::SolidLine,
+		Qt::RoundCap,
+		Qt::RoundJoin);
 }
 
 } // namespace
@@ -92,14 +47,13 @@ void ItemCanvas::clearPixmap() {
 
 	_p = std::make_unique<Painter>(&_pixmap);
 	_hq = std::make_unique<PainterHighQualityEnabler>(*_p);
-	_p->setPen(Qt::NoPen);
-	_p->setBrush(_brushData.color);
+	_p->setPen(BrushPen(_brushData.color, _brushData.size));
 }
 
 void ItemCanvas::applyBrush(const QColor &color, float size) {
 	_brushData.color = color;
 	_brushData.size = size;
-	_p->setBrush(color);
+	_p->setPen(BrushPen(color, size));
 	_brushMargins = QMarginsF(size, size, size, size);// / 2.;
 }
 
@@ -132,14 +86,11 @@ void ItemCanvas::computeContentRect(const QPointF &p) {
 void ItemCanvas::drawLine(
 		const QPointF &currentPoint,
 		const QPointF &lastPoint) {
-	const auto halfBrushSize = _brushData.size / 2.;
-	const auto points = InterpolatedPoints(lastPoint, currentPoint);
-
 	_rectToUpdate |= NormalizedRect(currentPoint, lastPoint) + _brushMargins;
 
-	for (const auto &point : points) {
-		_p->drawEllipse(point, halfBrushSize, halfBrushSize);
-	}
+	// A wide pen with round caps covers the same area as a chain
+	// of brush-sized circles, but is rasterized in one pass.
+	_p->drawLine(lastPoint, currentPoint);
 }
 
 void ItemCanvas::handleMousePressEvent(
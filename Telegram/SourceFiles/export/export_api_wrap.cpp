@@ -22,7 +22,7 @@ namespace Export {
 namespace {
 
 constexpr auto kUserpicsSliceLimit = 100;
-constexpr auto kFileChunkSize = 128 * 1024;
+constexpr auto kFileChunkSize = 512 * 1024;
 constexpr auto kFileRequestsCount = 2;
 //constexpr auto kFileNextRequestDelay = crl::time(20);
 constexpr auto kChatsSliceLimit = 100;
@@ -301,7 +301,12 @@ void ApiWrap::LoadedFileCache::save(
 		return;
 	}
 	const auto key = ComputeLocationKey(location);
-	_map[key] = relativePath;
+	const auto [i, inserted] = _map.emplace(key, relativePath);
+	if (!inserted) {
+		// Don't let a repeated key push other files out of the cache.
+		i->second = relativePath;
+		return;
+	}
 	_list.push_back(key);
 	if (_list.size() > _limit) {
 		const auto key = _list.front();
@@ -1404,7 +1409,9 @@ void ApiWrap::requestChatMessages(
 	const auto doneHandler = [=](MTPmessages_Messages &&result) {
 		Expects(_chatProcess != nullptr);
 
-		base::take(_chatProcess->requestDone)(std::move(result));
+		if (auto done = base::take(_chatProcess->requestDone)) {
+			done(std::move(result));
+		}
 	};
 	const auto splitsCount = int(_splits.size());
 	const auto realPeerInput = (splitIndex >= 0)
@@ -1545,16 +1552,14 @@ void ApiWrap::finishMessagesSlice() {
 	Expects(_chatProcess->slice.has_value());
 
 	auto slice = *base::take(_chatProcess->slice);
-	if (!slice.list.empty()) {
+	const auto handle = !slice.list.empty();
+	if (handle) {
 		_chatProcess->largestIdPlusOne = slice.list.back().id + 1;
 		const auto splitIndex = _chatProcess->info.splits[
 			_chatProcess->localSplitIndex];
 		if (splitIndex < 0) {
 			slice = AdjustMigrateMessageIds(std::move(slice));
 		}
-		if (!_chatProcess->handleSlice(std::move(slice))) {
-			return;
-		}
 	}
 	if (_chatProcess->lastSlice
 		&& (++_chatProcess->localSplitIndex
@@ -1562,7 +1567,24 @@ void ApiWrap::finishMessagesSlice() {
 		_chatProcess->lastSlice = false;
 		_chatProcess->largestIdPlusOne = 1;
 	}
-	if (!_chatProcess->lastSlice) {
+
+	// Request the next slice before writing this one, so that the writer
+	// works while the request is in flight. Empty splits are finished
+	// synchronously, so they have to wait for this slice to be written.
+	const auto requestNext = !_chatProcess->lastSlice;
+	const auto prefetch = requestNext
+		&& (_chatProcess->info.messagesCountPerSplit[
+			_chatProcess->localSplitIndex] > 0);
+	if (prefetch) {
+		requestMessagesSlice();
+	}
+	if (handle && !_chatProcess->handleSlice(std::move(slice))) {
+		_chatProcess->requestDone = nullptr;
+		return;
+	}
+	if (prefetch) {
+		return;
+	} else if (requestNext) {
 		requestMessagesSlice();
 	} else {
 		finishMessages();
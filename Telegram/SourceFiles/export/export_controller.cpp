@@ -109,6 +109,7 @@ private:
 	int _dialogIndex = -1;
 
 	int _messagesWritten = 0;
+	int64 _messagesWrittenTotal = 0;
 	int _messagesCount = 0;
 
 	int _userpicsWritten = 0;
@@ -119,6 +120,7 @@ private:
 	rpl::event_stream<State> _stateChanges;
 
 	Output::Stats _stats;
+	crl::time _startedAt = 0;
 
 	std::vector<int> _substepsInStep;
 	int _substepsTotal = 0;
@@ -363,6 +365,7 @@ void ControllerObject::initialized(const ApiWrap::StartInfo &info) {
 	if (ioCatchError(_writer->start(_settings, _environment, &_stats))) {
 		return;
 	}
+	_startedAt = crl::now();
 	fillSubstepsInSteps(info);
 	exportNext();
 }
@@ -477,6 +480,7 @@ void ControllerObject::exportNextDialog() {
 				return false;
 			}
 			_messagesWritten += result.list.size();
+			_messagesWrittenTotal += result.list.size();
 			setState(stateDialogs(DownloadProgress()));
 			return true;
 		}, [=] {
@@ -508,6 +512,16 @@ ProcessingState ControllerObject::prepareState(
 	result.substepsPassed = _substepsPassed;
 	result.substepsNow = substepsInStep(_lastProcessingStep);
 	result.substepsTotal = _substepsTotal;
+	result.bytesWritten = _stats.bytesCount();
+	if (const auto elapsed = _startedAt ? (crl::now() - _startedAt) : 0) {
+		result.bytesPerSecond = result.bytesWritten * 1000 / elapsed;
+		result.messagesPerSecond = _messagesWrittenTotal * 1000 / elapsed;
+		if (result.substepsPassed > 0) {
+			result.estimatedLeft = elapsed
+				* (result.substepsTotal - result.substepsPassed)
+				/ result.substepsPassed;
+		}
+	}
 	return result;
 }
 
@@ -603,10 +617,16 @@ int ControllerObject::substepsInStep(Step step) const {
 }
 
 void ControllerObject::setFinishedState() {
+	const auto duration = _startedAt ? (crl::now() - _startedAt) : 0;
+	LOG(("Export Info: Finished in %1 ms, %2 files, %3 bytes.").arg(
+		QString::number(duration),
+		QString::number(_stats.filesCount()),
+		QString::number(_stats.bytesCount())));
 	setState(FinishedState{
 		_writer->mainFilePath(),
 		_stats.filesCount(),
-		_stats.bytesCount() });
+		_stats.bytesCount(),
+		duration });
 }
 
 Controller::Controller(
@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QtCore/QPointer>
 #include <crl/crl_object_on_queue.h>
+#include <crl/crl_time.h>
 
 namespace MTP {
 class Instance;
@@ -79,6 +80,12 @@ struct ProcessingState {
 	QString bytesName;
 	int bytesLoaded = 0;
 	int bytesCount = 0;
+
+	// Throughput since the export start, the estimate is by substeps.
+	int64 bytesWritten = 0;
+	int64 bytesPerSecond = 0;
+	int64 messagesPerSecond = 0;
+	crl::time estimatedLeft = 0;
 };
 
 struct ApiErrorState {
@@ -96,6 +103,7 @@ struct FinishedState {
 	QString path;
 	int filesCount = 0;
 	int64 bytesCount = 0;
+	crl::time duration = 0;
 };
 
 using State = std::variant<
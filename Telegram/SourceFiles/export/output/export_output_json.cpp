@@ -28,22 +28,35 @@ QByteArray SerializeString(const QByteArray &value) {
 	const auto begin = value.data();
 	const auto end = begin + size;
 
+	// Most of the text needs no escaping, so copy it by whole runs.
 	auto result = QByteArray();
-	result.reserve(2 + size * 4);
+	result.reserve(2 + size + size / 8);
 	result.append('"');
+	auto from = begin;
+	const auto flush = [&](const char *till) {
+		if (till != from) {
+			result.append(from, till - from);
+		}
+	};
 	for (auto p = begin; p != end; ++p) {
 		const auto ch = *p;
 		if (ch == '\n') {
+			flush(p);
 			result.append("\\n", 2);
 		} else if (ch == '\r') {
+			flush(p);
 			result.append("\\r", 2);
 		} else if (ch == '\t') {
+			flush(p);
 			result.append("\\t", 2);
 		} else if (ch == '"') {
+			flush(p);
 			result.append("\\\"", 2);
 		} else if (ch == '\\') {
+			flush(p);
 			result.append("\\\\", 2);
 		} else if (ch >= 0 && ch < 32) {
+			flush(p);
 			result.append("\\x", 2).append('0' + (ch >> 4));
 			const auto left = (ch & 0x0F);
 			if (left >= 10) {
@@ -55,16 +68,21 @@ QByteArray SerializeString(const QByteArray &value) {
 			&& (p + 2 < end)
 			&& *(p + 1) == char(0x80)) {
 			if (*(p + 2) == char(0xA8)) { // Line separator.
+				flush(p);
 				result.append("\\u2028", 6);
 			} else if (*(p + 2) == char(0xA9)) { // Paragraph separator.
+				flush(p);
 				result.append("\\u2029", 6);
 			} else {
-				result.append(ch);
+				continue;
 			}
+			p += 2;
 		} else {
-			result.append(ch);
+			continue;
 		}
+		from = p + 1;
 	}
+	flush(end);
 	result.append('"');
 	return result;
 }
@@ -99,8 +117,13 @@ QByteArray SerializeObject(
 	const auto guard = gsl::finally([&] { context.nesting.pop_back(); });
 	const auto next = '\n' + Indentation(context);
 
+	auto size = next.size() + indent.size() + 3;
+	for (const auto &[key, value] : values) {
+		size += next.size() + key.size() + value.size() + 5;
+	}
 	auto first = true;
 	auto result = QByteArray();
+	result.reserve(size);
 	result.append('{');
 	for (const auto &[key, value] : values) {
 		if (value.isEmpty()) {
@@ -124,8 +147,13 @@ QByteArray SerializeArray(
 	const auto indent = Indentation(context.nesting.size());
 	const auto next = '\n' + Indentation(context.nesting.size() + 1);
 
+	auto size = indent.size() + 3;
+	for (const auto &value : values) {
+		size += next.size() + value.size() + 1;
+	}
 	auto first = true;
 	auto result = QByteArray();
+	result.reserve(size);
 	result.append('[');
 	for (const auto &value : values) {
 		if (first) {
@@ -31,11 +31,28 @@ Content ContentFromState(
 		result.rows.push_back({ id, label, info, progress, randomId });
 	};
 	const auto pushMain = [&](const QString &label) {
-		const auto info = (state.entityCount > 0)
+		const auto progress = (state.entityCount > 0)
 			? (QString::number(state.entityIndex + 1)
 				+ " / "
 				+ QString::number(state.entityCount))
 			: QString();
+		const auto info = (progress.isEmpty() || !state.bytesPerSecond)
+			? progress
+			: (state.estimatedLeft > 0)
+			? tr::lng_export_state_speed_left(
+				tr::now,
+				lt_progress,
+				progress,
+				lt_speed,
+				Ui::FormatSizeText(state.bytesPerSecond),
+				lt_time,
+				Ui::FormatDurationWords(state.estimatedLeft / 1000))
+			: tr::lng_export_state_speed(
+				tr::now,
+				lt_progress,
+				progress,
+				lt_speed,
+				Ui::FormatSizeText(state.bytesPerSecond));
 		if (!state.substepsTotal) {
 			push("main", label, info, 0.);
 			return;
@@ -95,10 +112,15 @@ Content ContentFromState(
 	case Step::OtherData:
 		pushMain(tr::lng_export_option_other(tr::now));
 		break;
-	case Step::Dialogs:
+	case Step::Dialogs: {
 		if (state.entityCount > 1) {
 			pushMain(tr::lng_export_state_chats(tr::now));
 		}
+		const auto progress = (state.itemCount > 0)
+			? (QString::number(state.itemIndex)
+				+ " / "
+				+ QString::number(state.itemCount))
+			: QString();
 		push(
 			"chat" + QString::number(state.entityIndex),
 			(state.entityName.isEmpty()
@@ -108,11 +130,14 @@ Content ContentFromState(
 				: (state.entityType == ProcessingState::EntityType::SavedMessages)
 				? tr::lng_saved_messages(tr::now)
 				: tr::lng_replies_messages(tr::now)),
-			(state.itemCount > 0
-				? (QString::number(state.itemIndex)
-					+ " / "
-					+ QString::number(state.itemCount))
-				: QString()),
+			((progress.isEmpty() || !state.messagesPerSecond)
+				? progress
+				: tr::lng_export_state_messages_speed(
+					tr::now,
+					lt_progress,
+					progress,
+					lt_speed,
+					QString::number(state.messagesPerSecond))),
 			(state.itemCount > 0
 				? (state.itemIndex / float64(state.itemCount))
 				: 0.));
@@ -123,7 +148,7 @@ Content ContentFromState(
 				+ QString::number(state.itemIndex)),
 			state.bytesName,
 			state.bytesRandomId);
-		break;
+	} break;
 	default: Unexpected("Step in ContentFromState.");
 	}
 	const auto requiredRows = settings->onlySinglePeer() ? 2 : 3;
@@ -156,6 +181,16 @@ Content ContentFromState(const FinishedState &state) {
 			Ui::FormatSizeText(state.bytesCount)),
 		QString(),
 		1. });
+	if (state.duration > 0) {
+		result.rows.push_back({
+			Content::kDoneId,
+			tr::lng_export_total_time(
+				tr::now,
+				lt_time,
+				Ui::FormatDurationWords(state.duration / 1000)),
+			QString(),
+			1. });
+	}
 	return result;
 }
 
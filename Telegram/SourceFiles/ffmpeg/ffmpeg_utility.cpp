@@ -360,6 +360,15 @@ SwscalePointer MakeSwscalePointer(
 		return SwscalePointer();
 	}
 
+	// Without resize swscale picks its unscaled SIMD converters anyway,
+	// for downscale bilinear is visually the same as bicubic and faster.
+	const auto downscale = (dstSize.width() < srcSize.width())
+		|| (dstSize.height() < srcSize.height());
+	const auto flags = (dstSize == srcSize)
+		? SWS_POINT
+		: downscale
+		? SWS_BILINEAR
+		: SWS_BICUBIC;
 	const auto result = sws_getCachedContext(
 		existing ? existing->release() : nullptr,
 		srcSize.width(),
@@ -368,7 +377,7 @@ SwscalePointer MakeSwscalePointer(
 		dstSize.width(),
 		dstSize.height(),
 		AVPixelFormat(dstFormat),
-		0,
+		flags,
 		nullptr,
 		nullptr,
 		nullptr);
@@ -1460,7 +1460,7 @@ void InnerWidget::suggestRestrictParticipant(
 				}
 			}).fail([=] {
 				editRestrictions(false, ChatRestrictionsInfo());
-			}).send();
+			}).shareIdentical().send();
 		}
 	});
 }
@@ -2780,6 +2780,25 @@ void History::resizeToWidth(int newWidth) {
 	_height = y;
 }
 
+void History::unloadTopBlocks(int count) {
+	Expects(count > 0 && count < int(blocks.size()));
+	Expects(!isBuildingFrontBlock());
+
+	while (count-- > 0) {
+		const auto block = blocks.front().get();
+		while (blocks.front().get() == block) {
+			const auto item = block->messages.front()->data();
+			if (item == _joinedMessage) {
+				removeJoinedMessage();
+			} else {
+				item->removeMainView();
+			}
+		}
+	}
+	_loadedAtTop = false;
+	owner().notifyHistoryChangeDelayed(this);
+}
+
 void History::forceFullResize() {
 	_width = 0;
 	_flags |= Flag::HasPendingResizedItems;
@@ -319,6 +319,9 @@ public:
 	void forceFullResize();
 	int height() const;
 
+	// Drops the views of the first blocks, they'll be loaded again.
+	void unloadTopBlocks(int count);
+
 	void itemRemoved(not_null<HistoryItem*> item);
 	void itemVanished(not_null<HistoryItem*> item);
 
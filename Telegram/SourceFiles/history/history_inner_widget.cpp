@@ -23,6 +23,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/history_view_quick_action.h"
 #include "history/view/history_view_react_button.h"
 #include "history/view/history_view_emoji_interactions.h"
+#include "history/view/history_view_paint_stats.h"
 #include "history/history_item_components.h"
 #include "history/history_item_text.h"
 #include "ui/chat/chat_style.h"
@@ -97,6 +98,7 @@ namespace {
 
 constexpr auto kScrollDateHideTimeout = 1000;
 constexpr auto kUnloadHeavyPartsPages = 2;
+constexpr auto kPreloadMediaPages = 1;
 constexpr auto kClearUserpicsAfter = 50;
 
 // Helper binary search for an item in a list that is not completely
@@ -864,6 +866,10 @@ void HistoryInner::paintEvent(QPaintEvent *e) {
 		mouseActionUpdate();
 	}
 
+	using Clock = std::chrono::steady_clock;
+	const auto measure = HistoryView::PaintStatsEnabled();
+	const auto frameGuard = HistoryView::FramePaintGuard(u"history"_q);
+
 	Painter p(this);
 	auto clip = e->rect();
 
@@ -872,6 +878,18 @@ void HistoryInner::paintEvent(QPaintEvent *e) {
 		0,
 		width(),
 		std::min(st::msgMaxWidth / 2, width() / 2));
+	const auto drawView = [&](not_null<Element*> view) {
+		if (!measure) {
+			view->draw(p, context);
+			return;
+		}
+		const auto started = Clock::now();
+		view->draw(p, context);
+		HistoryView::RecordElementPaint(
+			view,
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				Clock::now() - started));
+	};
 
 	const auto now = crl::now();
 	const auto historyDisplayedEmpty = _history->isDisplayedEmpty()
@@ -994,7 +1012,7 @@ void HistoryInner::paintEvent(QPaintEvent *e) {
 				view,
 				selfromy - mtop,
 				seltoy - mtop);
-			view->draw(p, context);
+			drawView(view);
 			processPainted(view, top, height);
 
 			top += height;
@@ -1038,7 +1056,7 @@ void HistoryInner::paintEvent(QPaintEvent *e) {
 					view,
 					selfromy - htop,
 					seltoy - htop);
-				view->draw(p, context);
+				drawView(view);
 				processPainted(view, top, height);
 			}
 			top += height;
@@ -2817,6 +2835,14 @@ void HistoryInner::visibleAreaUpdated(int top, int bottom) {
 			from,
 			till);
 	}
+
+	// Start loading the media of the next page in the scroll direction.
+	const auto preload = kPreloadMediaPages * visibleAreaHeight;
+	if (scrolledUp) {
+		preloadMedia(_visibleAreaTop - preload, _visibleAreaTop);
+	} else {
+		preloadMedia(_visibleAreaBottom, _visibleAreaBottom + preload);
+	}
 	checkHistoryActivation();
 
 	_emojiInteractions->visibleAreaUpdated(
@@ -2824,6 +2850,34 @@ void HistoryInner::visibleAreaUpdated(int top, int bottom) {
 		_visibleAreaBottom - _historyPaddingTop);
 }
 
+void HistoryInner::preloadMedia(int from, int till) {
+	const auto preload = [&](History *history, int historyTop) {
+		if (!history || historyTop < 0) {
+			return;
+		}
+		for (const auto &block : history->blocks) {
+			const auto blockTop = historyTop + block->y();
+			if (blockTop >= till) {
+				break;
+			} else if (blockTop + block->height() <= from) {
+				continue;
+			}
+			for (const auto &view : block->messages) {
+				const auto top = blockTop + view->y();
+				if (top >= till) {
+					break;
+				} else if (top + view->height() <= from) {
+					continue;
+				} else if (const auto media = view->media()) {
+					media->preloadContent();
+				}
+			}
+		}
+	};
+	preload(_migrated, migratedTop());
+	preload(_history, historyTop());
+}
+
 bool HistoryInner::displayScrollDate() const {
 	return (_visibleAreaTop <= height() - 2 * (_visibleAreaBottom - _visibleAreaTop));
 }
@@ -153,6 +153,7 @@ public:
 
 	// updates history->scrollTopItem/scrollTopOffset
 	void visibleAreaUpdated(int top, int bottom);
+	void preloadMedia(int from, int till);
 
 	int historyHeight() const;
 	int historyScrollTop() const;
@@ -168,12 +168,15 @@ namespace {
 constexpr auto kMessagesPerPageFirst = 30;
 constexpr auto kMessagesPerPage = 50;
 constexpr auto kPreloadHeightsCount = 3; // when 3 screens to scroll left make a preload request
+constexpr auto kUnloadHeightsCount = 10;
 constexpr auto kScrollToVoiceAfterScrolledMs = 1000;
 constexpr auto kSkipRepaintWhileScrollMs = 100;
 constexpr auto kShowMembersDropdownTimeoutMs = 300;
 constexpr auto kDisplayEditTimeWarningMs = 300 * 1000;
 constexpr auto kFullDayInMs = 86400 * 1000;
 constexpr auto kSaveDraftTimeout = 1000;
+constexpr auto kPreviewCacheLimit = 256;
+constexpr auto kPreviewEmptyCacheTimeout = 10 * 60 * crl::time(1000);
 constexpr auto kSaveDraftAnywayTimeout = 5000;
 constexpr auto kSaveCloudDraftIdleTimeout = 14000;
 constexpr auto kRefreshSlowmodeLabelTimeout = crl::time(200);
@@ -2177,7 +2180,6 @@ void HistoryWidget::showHistory(
 	_replyEditMsg = nullptr;
 	_editMsgId = _replyToId = 0;
 	_previewData = nullptr;
-	_previewCache.clear();
 	_fieldBarCancel->hide();
 
 	_membersDropdownShowTimer.cancel();
@@ -2381,6 +2383,11 @@ void HistoryWidget::setHistory(History *history) {
 		_attachToggle->installEventFilter(_attachBotsMenu.get());
 	}
 
+	const auto setOpened = [](History *history, bool opened) {
+		if (history) {
+			history->owner().histories().setOpened(history, opened);
+		}
+	};
 	const auto unloadHeavyViewParts = [](History *history) {
 		if (history) {
 			history->owner().unloadHeavyViewParts(
@@ -2397,10 +2404,14 @@ void HistoryWidget::setHistory(History *history) {
 		const auto wasMigrated = base::take(_migrated);
 		unloadHeavyViewParts(wasHistory);
 		unloadHeavyViewParts(wasMigrated);
+		setOpened(wasHistory, false);
+		setOpened(wasMigrated, false);
 	}
 	if (history) {
 		_history = history;
 		_migrated = _history ? _history->migrateFrom() : nullptr;
+		setOpened(_history, true);
+		setOpened(_migrated, true);
 		registerDraftSource();
 	}
 }
@@ -5692,8 +5703,40 @@ void HistoryWidget::addMessagesToBack(
 		createUnreadBarAndResize();
 	}
 	if (!_firstLoadRequest) {
-		updateHistoryGeometry(false, true, { ScrollChangeNoJumpToBottom, 0 });
+		if (unloadFarTopBlocks()) {
+			// Keep the scroll position by the scroll top item.
+			updateHistoryGeometry(false, true, { ScrollChangeAdd, 0 });
+		} else {
+			updateHistoryGeometry(
+				false,
+				true,
+				{ ScrollChangeNoJumpToBottom, 0 });
+		}
+	}
+}
+
+bool HistoryWidget::unloadFarTopBlocks() {
+	if (_preloadRequest
+		|| !_history->scrollTopItem
+		|| (_migrated && !_migrated->isEmpty())) {
+		return false;
+	}
+	const auto till = _scroll->scrollTop()
+		- kUnloadHeightsCount * _scroll->height();
+	const auto &blocks = _history->blocks;
+	auto count = 0;
+	while (count + 1 < int(blocks.size())) {
+		const auto last = blocks[count]->messages.back().get();
+		if (_list->itemTop(last) + last->height() >= till) {
+			break;
+		}
+		++count;
+	}
+	if (!count) {
+		return false;
 	}
+	_history->unloadTopBlocks(count);
+	return true;
 }
 
 void HistoryWidget::updateBotKeyboard(History *h, bool force) {
@@ -7086,7 +7129,21 @@ void HistoryWidget::checkPreview() {
 			}
 		} else {
 			const auto i = _previewCache.constFind(links);
-			if (i == _previewCache.cend()) {
+			const auto page = (i != _previewCache.cend() && i.value())
+				? session().data().webpage(i.value()).get()
+				: nullptr;
+			const auto empty = _previewEmptyCache.find(links);
+			if (empty != end(_previewEmptyCache)
+				&& empty->second + kPreviewEmptyCacheTimeout > crl::now()) {
+				if (_previewData && _previewData->pendingTill >= 0) {
+					previewCancel();
+				}
+			} else if (page && page->pendingTill >= 0) {
+				// Pending pages are re-requested by the preview timer.
+				_previewData = page;
+				updatePreview();
+			} else {
+				// Not known, or a pending page that didn't get its content.
 				_previewRequest = _api.request(MTPmessages_GetWebPagePreview(
 					MTP_flags(0),
 					MTP_string(links),
@@ -7094,11 +7151,6 @@ void HistoryWidget::checkPreview() {
 				)).done([=](const MTPMessageMedia &result, mtpRequestId requestId) {
 					gotPreview(links, result, requestId);
 				}).send();
-			} else if (i.value()) {
-				_previewData = session().data().webpage(i.value());
-				updatePreview();
-			} else if (_previewData && _previewData->pendingTill >= 0) {
-				previewCancel();
 			}
 		}
 	}
@@ -7127,10 +7179,22 @@ void HistoryWidget::gotPreview(
 	if (req == _previewRequest) {
 		_previewRequest = 0;
 	}
+	if (_previewCache.size() >= kPreviewCacheLimit) {
+		// Links → web page ids are kept across chats, just bound them.
+		_previewCache.clear();
+	}
+	if (_previewEmptyCache.size() >= kPreviewCacheLimit) {
+		_previewEmptyCache.clear();
+	}
+	_previewEmptyCache.remove(links);
 	if (result.type() == mtpc_messageMediaWebPage) {
 		const auto &data = result.c_messageMediaWebPage().vwebpage();
 		const auto page = session().data().processWebpage(data);
-		_previewCache.insert(links, page->id);
+		if (page->id) {
+			_previewCache.insert(links, page->id);
+		} else {
+			_previewEmptyCache.emplace(links, crl::now());
+		}
 		if (page->pendingTill > 0
 			&& page->pendingTill <= base::unixtime::now()) {
 			page->pendingTill = -1;
@@ -7144,7 +7208,8 @@ void HistoryWidget::gotPreview(
 		}
 		session().data().sendWebPageGamePollNotifications();
 	} else if (result.type() == mtpc_messageMediaEmpty) {
-		_previewCache.insert(links, 0);
+		_previewCache.remove(links);
+		_previewEmptyCache.emplace(links, crl::now());
 		if (links == _previewLinks
 			&& _previewState == Data::PreviewState::Allowed) {
 			_previewData = nullptr;
@@ -550,6 +550,7 @@ private:
 	void messagesFailed(const MTP::Error &error, int requestId);
 	void addMessagesToFront(PeerData *peer, const QVector<MTPMessage> &messages);
 	void addMessagesToBack(PeerData *peer, const QVector<MTPMessage> &messages);
+	[[nodiscard]] bool unloadFarTopBlocks();
 
 	void updateHistoryGeometry(bool initial = false, bool loadedDown = false, const ScrollChange &change = { ScrollChangeNone, 0 });
 	void updateListSize();
@@ -672,6 +673,7 @@ private:
 	WebPageData *_previewData = nullptr;
 	typedef QMap<QString, WebPageId> PreviewCache;
 	PreviewCache _previewCache;
+	base::flat_map<QString, crl::time> _previewEmptyCache;
 	mtpRequestId _previewRequest = 0;
 	Ui::Text::String _previewTitle;
 	Ui::Text::String _previewDescription;
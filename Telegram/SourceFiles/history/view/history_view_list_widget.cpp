@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/history_view_cursor_state.h"
 #include "history/view/history_view_react_button.h"
 #include "history/view/history_view_quick_action.h"
+#include "history/view/history_view_paint_stats.h"
 #include "chat_helpers/message_field.h"
 #include "mainwindow.h"
 #include "mainwidget.h"
@@ -1766,6 +1767,7 @@ void ListWidget::paintEvent(QPaintEvent *e) {
 	const auto guard = gsl::finally([&] {
 		_userpicsCache.clear();
 	});
+	const auto frameGuard = FramePaintGuard(u"list"_q);
 
 	Painter p(this);
 
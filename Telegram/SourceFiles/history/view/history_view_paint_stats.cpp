@@ -0,0 +1,125 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "history/view/history_view_paint_stats.h"
+
+#include "history/view/history_view_element.h"
+#include "history/view/media/history_view_media.h"
+#include "history/history_item.h"
+#include "mtproto/details/mtproto_stats_histogram.h"
+#include "base/flat_map.h"
+
+#include <typeinfo>
+
+namespace HistoryView {
+namespace {
+
+// Durations are in microseconds.
+constexpr auto kBucketsCount = 20;
+
+struct Key {
+	bool service = false;
+	const std::type_info *media = nullptr;
+
+	friend inline bool operator<(const Key &a, const Key &b) {
+		return std::tie(a.service, a.media) < std::tie(b.service, b.media);
+	}
+};
+
+using Histogram = MTP::details::Log2Histogram<kBucketsCount>;
+
+struct Stats {
+	bool enabled = false;
+	base::flat_map<Key, Histogram> elements;
+	base::flat_map<QString, Histogram> frames;
+};
+
+Stats &Instance() {
+	static auto result = Stats();
+	return result;
+}
+
+void Add(Histogram &histogram, std::chrono::microseconds duration) {
+	histogram.add(int64(duration.count()));
+}
+
+[[nodiscard]] QString Line(const QString &name, const Histogram &histogram) {
+	return u"%1 %2 %3 %4 %5 %6 %7 %8"_q
+		.arg(name)
+		.arg(histogram.count)
+		.arg(histogram.average())
+		.arg(histogram.percentile(50))
+		.arg(histogram.percentile(90))
+		.arg(histogram.percentile(99))
+		.arg(histogram.max)
+		.arg(histogram.sum);
+}
+
+} // namespace
+
+bool PaintStatsEnabled() {
+	return Instance().enabled;
+}
+
+void SetPaintStatsEnabled(bool enabled) {
+	auto &stats = Instance();
+	stats.enabled = enabled;
+	if (enabled) {
+		stats.elements.clear();
+		stats.frames.clear();
+	}
+}
+
+void RecordElementPaint(
+		not_null<const Element*> view,
+		std::chrono::microseconds duration) {
+	const auto media = view->media();
+	Add(Instance().elements[Key{
+		.service = view->data()->isService(),
+		.media = media ? &typeid(*media) : nullptr,
+	}], duration);
+}
+
+void RecordFramePaint(
+		const QString &surface,
+		std::chrono::microseconds duration) {
+	Add(Instance().frames[surface], duration);
+}
+
+QString DumpPaintStats() {
+	const auto &stats = Instance();
+	auto result = QStringList();
+	result.push_back(
+		"type count avg_us p50_us p90_us p99_us max_us total_us");
+	for (const auto &[surface, histogram] : stats.frames) {
+		result.push_back(Line(u"frame:"_q + surface, histogram));
+	}
+	for (const auto &[key, histogram] : stats.elements) {
+		const auto kind = key.service ? u"service"_q : u"message"_q;
+		const auto name = key.media
+			? (kind + ':' + QString::fromLatin1(key.media->name()))
+			: kind;
+		result.push_back(Line(name, histogram));
+	}
+	return result.join('\n');
+}
+
+FramePaintGuard::FramePaintGuard(QString surface)
+: _surface(PaintStatsEnabled() ? std::move(surface) : QString())
+, _started(_surface.isEmpty() ? Clock::time_point() : Clock::now()) {
+}
+
+FramePaintGuard::~FramePaintGuard() {
+	if (!_surface.isEmpty() && PaintStatsEnabled()) {
+		RecordFramePaint(
+			_surface,
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				Clock::now() - _started));
+	}
+}
+
+} // namespace HistoryView
@@ -0,0 +1,43 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <chrono>
+
+namespace HistoryView {
+
+class Element;
+
+// Paint time of history elements by element type and of whole frames
+// by painted surface ("history", "list", "dialogs").
+// Collected only while enabled from the settings codes, main thread only.
+[[nodiscard]] bool PaintStatsEnabled();
+void SetPaintStatsEnabled(bool enabled);
+void RecordElementPaint(
+	not_null<const Element*> view,
+	std::chrono::microseconds duration);
+void RecordFramePaint(
+	const QString &surface,
+	std::chrono::microseconds duration);
+[[nodiscard]] QString DumpPaintStats();
+
+// Records the lifetime of the guard as one frame of the surface.
+class FramePaintGuard final {
+public:
+	explicit FramePaintGuard(QString surface);
+	~FramePaintGuard();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	const QString _surface;
+	const Clock::time_point _started;
+
+};
+
+} // namespace HistoryView
@@ -578,6 +578,13 @@ void Document::unloadHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Document::preloadContent() const {
+	ensureDataMediaCreated();
+	if (!_dataMedia->canBePlayed(_realParent)) {
+		_dataMedia->automaticLoad(_realParent->fullId(), _realParent);
+	}
+}
+
 void Document::ensureDataMediaCreated() const {
 	if (_dataMedia) {
 		return;
@@ -87,6 +87,7 @@ public:
 
 	bool hasHeavyPart() const override;
 	void unloadHeavyPart() override;
+	void preloadContent() const override;
 
 protected:
 	float64 dataProgress() const override;
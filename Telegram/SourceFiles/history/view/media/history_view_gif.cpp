@@ -1467,6 +1467,10 @@ void Gif::unloadHeavyPart() {
 	_videoThumbnailFrame = nullptr;
 }
 
+void Gif::preloadContent() const {
+	ensureDataMediaCreated();
+}
+
 void Gif::refreshParentId(not_null<HistoryItem*> realParent) {
 	File::refreshParentId(realParent);
 	if (_parent->media() == this) {
@@ -114,6 +114,7 @@ public:
 
 	bool hasHeavyPart() const override;
 	void unloadHeavyPart() override;
+	void preloadContent() const override;
 
 	void refreshParentId(not_null<HistoryItem*> realParent) override;
 
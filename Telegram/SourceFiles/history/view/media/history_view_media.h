@@ -296,6 +296,10 @@ public:
 	virtual void unloadHeavyPart() {
 	}
 
+	// Starts the loads that the first paint would start.
+	virtual void preloadContent() const {
+	}
+
 	// Should be called only by Data::Session.
 	virtual void updateSharedContactUserId(UserId userId) {
 	}
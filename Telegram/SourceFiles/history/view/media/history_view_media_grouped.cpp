@@ -722,6 +722,12 @@ void GroupedMedia::unloadHeavyPart() {
 	}
 }
 
+void GroupedMedia::preloadContent() const {
+	for (const auto &part : _parts) {
+		part.content->preloadContent();
+	}
+}
+
 void GroupedMedia::parentTextUpdated() {
 	history()->owner().requestViewResize(_parent);
 }
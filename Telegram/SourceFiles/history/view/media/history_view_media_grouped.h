@@ -97,6 +97,7 @@ public:
 	void checkAnimation() override;
 	bool hasHeavyPart() const override;
 	void unloadHeavyPart() override;
+	void preloadContent() const override;
 
 	void parentTextUpdated() override;
 
@@ -135,6 +135,11 @@ void Photo::unloadHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Photo::preloadContent() const {
+	ensureDataMediaCreated();
+	_dataMedia->automaticLoad(_realParent->fullId(), _parent->data());
+}
+
 QSize Photo::countOptimalSize() {
 	if (_parent->media() != this) {
 		_caption = Ui::Text::String();
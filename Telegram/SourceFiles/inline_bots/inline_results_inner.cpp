@@ -385,6 +385,19 @@ void Inner::inlineBotChanged() {
 	refreshInlineRows(nullptr, nullptr, nullptr, true);
 }
 
+void Inner::inlineResultsDestroyed(const Results &results) {
+	const auto shown = ranges::any_of(results, [&](const auto &result) {
+		const auto i = _inlineLayouts.find(result.get());
+		return (i != end(_inlineLayouts)) && (i->second->position() >= 0);
+	});
+	if (shown) {
+		clearInlineRows(false);
+	}
+	for (const auto &result : results) {
+		_inlineLayouts.erase(result.get());
+	}
+}
+
 void Inner::clearInlineRows(bool resultsDeleted) {
 	if (resultsDeleted) {
 		_selected = _pressed = -1;
@@ -53,6 +53,7 @@ class ItemBase;
 using Results = std::vector<std::unique_ptr<Result>>;
 
 struct CacheEntry {
+	crl::time expires = 0;
 	QString nextOffset;
 	QString switchPmText, switchPmStartToken;
 	Results results;
@@ -72,6 +73,7 @@ public:
 
 	int refreshInlineRows(PeerData *queryPeer, UserData *bot, const CacheEntry *results, bool resultsDeleted);
 	void inlineBotChanged();
+	void inlineResultsDestroyed(const Results &results);
 	void hideInlineRowsPanel();
 	void clearInlineRowsPanel();
 
@@ -24,6 +24,7 @@ namespace Layout {
 namespace {
 
 constexpr auto kInlineBotRequestDelay = 400;
+constexpr auto kPreloadScreens = 2;
 
 } // namespace
 
@@ -290,7 +291,8 @@ void Widget::showStarted() {
 
 void Widget::onScroll() {
 	auto st = _scroll->scrollTop();
-	if (st + _scroll->height() > _scroll->scrollTopMax()) {
+	if (st + kPreloadScreens * _scroll->height()
+		> _scroll->scrollTopMax()) {
 		onInlineRequest();
 	}
 	_inner->setVisibleTopBottom(st, st + _scroll->height());
@@ -363,6 +365,9 @@ void Widget::inlineResultsDone(const MTPmessages_BotResults &result) {
 				std::make_unique<CacheEntry>()).first;
 		}
 		auto entry = it->second.get();
+		if (!adding) {
+			entry->expires = crl::now() + d.vcache_time().v * crl::time(1000);
+		}
 		entry->nextOffset = qs(d.vnext_offset().value_or_empty());
 		if (const auto switchPm = d.vswitch_pm()) {
 			switchPm->match([&](const MTPDinlineBotSwitchPM &data) {
@@ -414,6 +419,12 @@ void Widget::queryInlineBot(UserData *bot, PeerData *peer, QString query) {
 			_inlineRequestId = 0;
 			_requesting.fire(false);
 		}
+		const auto i = _inlineCache.find(query);
+		if (i != _inlineCache.cend() && i->second->expires <= crl::now()) {
+			// Layouts are keyed by the results we are about to destroy.
+			_inner->inlineResultsDestroyed(i->second->results);
+			_inlineCache.erase(i);
+		}
 		if (_inlineCache.find(query) != _inlineCache.cend()) {
 			_inlineRequestTimer.cancel();
 			_inlineQuery = _inlineNextQuery = query;
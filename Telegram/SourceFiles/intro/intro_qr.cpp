@@ -327,6 +327,7 @@ void QrWidget::handleTokenResult(const MTPauth_LoginToken &result) {
 	result.match([&](const MTPDauth_loginToken &data) {
 		_requestId = 0;
 		showToken(data.vtoken().v);
+		prepareOtherDcs();
 
 		if (base::take(_forceRefresh)) {
 			refreshCode();
@@ -357,6 +358,29 @@ void QrWidget::showToken(const QByteArray &token) {
 	_qrCodes.fire_copy("tg://login?token=" + encoded);
 }
 
+void QrWidget::prepareOtherDcs() {
+	if (!_preparedDcs.empty()) {
+		return;
+	}
+	// The account may live in any DC, create the keys while the code
+	// is being scanned so that auth.loginTokenMigrateTo doesn't wait.
+	auto &instance = api().instance();
+	const auto mainDcId = instance.mainDcId();
+	for (const auto dcId : instance.dcOptions().configEnumDcIds()) {
+		if (dcId != mainDcId) {
+			_preparedDcs.push_back(dcId);
+			instance.sendAnything(dcId);
+		}
+	}
+}
+
+void QrWidget::stopOtherDcs() {
+	auto &instance = api().instance();
+	for (const auto dcId : base::take(_preparedDcs)) {
+		instance.stopSession(dcId);
+	}
+}
+
 void QrWidget::importTo(MTP::DcId dcId, const QByteArray &token) {
 	Expects(_requestId != 0);
 
@@ -421,6 +445,7 @@ void QrWidget::activate() {
 void QrWidget::finished() {
 	Step::finished();
 	_refreshTimer.cancel();
+	stopOtherDcs();
 	apiClear();
 	cancelled();
 }
@@ -43,11 +43,14 @@ private:
 	void showTokenError(const MTP::Error &error);
 	void importTo(MTP::DcId dcId, const QByteArray &token);
 	void showToken(const QByteArray &token);
+	void prepareOtherDcs();
+	void stopOtherDcs();
 	void done(const MTPauth_Authorization &authorization);
 
 	rpl::event_stream<QByteArray> _qrCodes;
 	base::Timer _refreshTimer;
 	mtpRequestId _requestId = 0;
+	std::vector<MTP::DcId> _preparedDcs;
 	bool _forceRefresh = false;
 
 };
@@ -206,6 +206,22 @@ void AbstractMosaicLayout::forEach(
 	}
 }
 
+void AbstractMosaicLayout::forEachOutside(
+		int top,
+		int bottom,
+		Fn<void(not_null<AbstractLayoutItem*>)> callback) const {
+	auto rowTop = _offset.y();
+	for (const auto &row : _rows) {
+		const auto rowBottom = rowTop + row.height;
+		if (rowBottom <= top || rowTop >= bottom) {
+			for (const auto &item : row.items) {
+				callback(item);
+			}
+		}
+		rowTop = rowBottom;
+	}
+}
+
 void AbstractMosaicLayout::paint(
 		Fn<void(not_null<AbstractLayoutItem*>, QPoint)> paintItem,
 		const QRect &clip) const {
@@ -51,6 +51,12 @@ protected:
 
 	void forEach(Fn<void(not_null<const AbstractLayoutItem*>)> callback);
 
+	// Items of the rows that don't intersect [top, bottom).
+	void forEachOutside(
+		int top,
+		int bottom,
+		Fn<void(not_null<AbstractLayoutItem*>)> callback) const;
+
 	void paint(
 		Fn<void(not_null<AbstractLayoutItem*>, QPoint)> paintItem,
 		const QRect &clip) const;
@@ -115,6 +121,16 @@ public:
 		});
 	}
 
+	void forEachOutside(
+			int top,
+			int bottom,
+			Fn<void(not_null<ItemBase*>)> callback) const {
+		Parent::forEachOutside(top, bottom, [&](
+				not_null<AbstractLayoutItem*> item) {
+			callback(Downcast(item));
+		});
+	}
+
 	void paint(
 			Fn<void(not_null<ItemBase*>, QPoint)> paintItem,
 			const QRect &clip) const {
@@ -12,8 +12,15 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/launcher.h"
 #include "mtproto/facade.h"
 
+#include <thread>
+#include <condition_variable>
+
 namespace {
 
+// Debug logs may get thousands of lines per second with mtproto traffic,
+// so they're flushed at most that often, unless the line is important.
+constexpr auto kDebugFlushInterval = crl::time(1000);
+
 std::atomic<int> ThreadCounter/* = 0*/;
 thread_local bool WritingEntryFlag/* = false*/;
 
@@ -77,6 +84,16 @@ public:
 		for (int32 i = 0; i < LogDataCount; ++i) {
 			files[i].reset(new QFile());
 		}
+		flusher = std::thread([=] { flushLoop(); });
+	}
+
+	~LogsDataFields() {
+		{
+			std::unique_lock<std::mutex> lock(flusherMutex);
+			flusherStopped = true;
+		}
+		flusherCondition.notify_one();
+		flusher.join();
 	}
 
 	bool openMain() {
@@ -110,7 +127,7 @@ public:
 		return QString();
 	}
 
-	void write(LogDataType type, const QString &msg) {
+	void write(LogDataType type, const QString &msg, bool important) {
 		QMutexLocker lock(_logsMutex(type));
 		WritingEntryScope scope;
 
@@ -122,11 +139,69 @@ public:
 			return;
 		}
 		file->write(msg.toUtf8());
-		file->flush();
+
+		const auto now = crl::now();
+		if (important
+			|| type == LogDataMain
+			|| now - flushed[type] >= kDebugFlushInterval) {
+			file->flush();
+			flushed[type] = now;
+			unflushed[type] = false;
+		} else {
+			unflushed[type] = true;
+		}
+	}
+
+	// Called from the crash handler, so it doesn't wait for the writers.
+	void flushBeforeCrash() {
+		for (auto type = 0; type != LogDataCount; ++type) {
+			const auto mutex = _logsMutex(LogDataType(type));
+			if (!mutex->tryLock()) {
+				continue;
+			}
+			if (files[type] && files[type]->isOpen()) {
+				files[type]->flush();
+			}
+			mutex->unlock();
+		}
 	}
 
 private:
+	void flushLoop() {
+		auto lock = std::unique_lock<std::mutex>(flusherMutex);
+		while (!flusherCondition.wait_for(
+				lock,
+				std::chrono::milliseconds(kDebugFlushInterval),
+				[=] { return flusherStopped; })) {
+			lock.unlock();
+			flushLagging();
+			lock.lock();
+		}
+	}
+
+	// The last lines before a pause in logging shouldn't wait for the
+	// next line to be flushed.
+	void flushLagging() {
+		for (auto type = 0; type != LogDataCount; ++type) {
+			QMutexLocker lock(_logsMutex(LogDataType(type)));
+			WritingEntryScope scope;
+
+			if (unflushed[type] && files[type] && files[type]->isOpen()) {
+				files[type]->flush();
+				flushed[type] = crl::now();
+			}
+			unflushed[type] = false;
+		}
+	}
+
 	std::unique_ptr<QFile> files[LogDataCount];
+	crl::time flushed[LogDataCount] = { 0 };
+	bool unflushed[LogDataCount] = { false };
+
+	std::thread flusher;
+	std::mutex flusherMutex;
+	std::condition_variable flusherCondition;
+	bool flusherStopped = false;
 
 	int32 part = -1;
 
@@ -259,10 +334,13 @@ LogsInMemoryList *DeletedLogsInMemory = SharedMemoryLocation<LogsInMemoryList, 0
 
 QString LogsBeforeSingleInstanceChecked; // LogsInMemory already dumped in LogsData, but LogsData is about to be deleted
 
-void _logsWrite(LogDataType type, const QString &msg) {
+void _logsWrite(
+		LogDataType type,
+		const QString &msg,
+		bool important = false) {
 	if (LogsData && (type == LogDataMain || LogsStartIndexChosen < 0)) {
 		if (type == LogDataMain || Logs::DebugEnabled()) {
-			LogsData->write(type, msg);
+			LogsData->write(type, msg, important);
 		}
 	} else if (LogsInMemory != DeletedLogsInMemory) {
 		if (!LogsInMemory) {
@@ -481,6 +559,12 @@ bool started() {
 	return LogsData != 0;
 }
 
+void flushBeforeCrash() {
+	if (LogsData) {
+		LogsData->flushBeforeCrash();
+	}
+}
+
 bool instanceChecked() {
 	if (!LogsData) return false;
 
@@ -548,7 +632,11 @@ void writeMain(const QString &v) {
 	).arg(v);
 	_logsWrite(LogDataMain, msg);
 
-	writeDebug(v);
+	// Main log lines are flushed to the debug log right away as well.
+	_logsWrite(
+		LogDataDebug,
+		QString("%1 %2\n").arg(_logsEntryStart(), v),
+		true);
 }
 
 void writeDebug(const QString &v) {
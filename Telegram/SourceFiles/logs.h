@@ -25,6 +25,9 @@ void start(not_null<Core::Launcher*> launcher);
 bool started();
 void finish();
 
+// Flushes the debug logs that are not being written right now.
+void flushBeforeCrash();
+
 bool instanceChecked();
 void multipleInstances();
 
@@ -466,6 +466,7 @@ void Mixer::Track::clear() {
 		samplesCount[i] = 0;
 		bufferSamples[i] = QByteArray();
 	}
+	preparedChunks.clear();
 
 	setExternalData(nullptr);
 	lastUpdateWhen = 0;
@@ -486,6 +487,7 @@ void Mixer::Track::started() {
 		samplesCount[i] = 0;
 		bufferSamples[i] = QByteArray();
 	}
+	preparedChunks.clear();
 }
 
 bool Mixer::Track::isStreamCreated() const {
@@ -545,6 +547,47 @@ int Mixer::Track::getNotQueuedBufferIndex() {
 	return -1;
 }
 
+void Mixer::Track::pushPreparedChunk(QByteArray &&samples, int64 count) {
+	Expects(!preparedChunksFull());
+
+	preparedChunks.push_back({
+		.samples = std::move(samples),
+		.count = count,
+	});
+}
+
+void Mixer::Track::queuePreparedChunks() {
+	if (!isStreamCreated()) {
+		return;
+	}
+	while (!preparedChunks.empty()) {
+		const auto index = getNotQueuedBufferIndex();
+		if (index < 0) {
+			return;
+		}
+		auto &chunk = preparedChunks.front();
+		samplesCount[index] = chunk.count;
+		bufferSamples[index] = std::move(chunk.samples);
+		bufferedLength += chunk.count;
+		preparedChunks.pop_front();
+
+		alBufferData(stream.buffers[index], format, bufferSamples[index].constData(), bufferSamples[index].size(), frequency);
+		alSourceQueueBuffers(stream.source, 1, stream.buffers + index);
+	}
+}
+
+bool Mixer::Track::preparedChunksFull() const {
+	return (preparedChunks.size() >= kPreparedChunksCount);
+}
+
+int64 Mixer::Track::preparedLength() const {
+	return ranges::accumulate(
+		preparedChunks,
+		int64(0),
+		ranges::plus(),
+		&PreparedChunk::count);
+}
+
 void Mixer::Track::setExternalData(
 		std::unique_ptr<ExternalSoundData> data) {
 	changeSpeedEffect(data ? data->speed : 1.);
@@ -1397,6 +1440,11 @@ int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasF
 		return false;
 	};
 
+	if (!track->preparedChunks.empty()) {
+		track->queuePreparedChunks();
+		if (errorHappened()) return EmitError;
+	}
+
 	ALint alSampleOffset = 0;
 	ALint alState = AL_INITIAL;
 	alGetSourcei(track->stream.source, AL_SAMPLE_OFFSET, &alSampleOffset);
@@ -1489,7 +1537,13 @@ int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasF
 	}
 	if (playing || track->state.state == State::Starting || track->state.state == State::Resuming) {
 		if (!track->loaded && !track->loading) {
-			auto needPreload = (track->state.position + kPreloadSamples > track->bufferedPosition + track->bufferedLength);
+			// Keep the prepared chunks full, so that processed buffers
+			// are refilled without waiting for the loader thread.
+			const auto bufferedTill = track->bufferedPosition
+				+ track->bufferedLength
+				+ track->preparedLength();
+			auto needPreload = !track->preparedChunksFull()
+				|| (track->state.position + kPreloadSamples > bufferedTill);
 			if (needPreload) {
 				track->loading = true;
 				emitSignals |= EmitNeedToPreload;
@@ -1746,13 +1800,23 @@ public:
 
 		auto fmt = format();
 		auto peak = uint16(0);
-		auto callback = [&](uint16 sample) {
-			accumulate_max(peak, sample);
-			sumbytes += Media::Player::kWaveformSamplesCount;
-			if (sumbytes >= countbytes) {
-				sumbytes -= countbytes;
-				peaks.push_back(peak);
-				peak = 0;
+		const auto each = int64(Media::Player::kWaveformSamplesCount);
+		const auto consume = [&](const auto *samples, int64 count) {
+			while (count > 0) {
+				// Take the run of samples till the next peak boundary.
+				const auto left = (countbytes - sumbytes + each - 1) / each;
+				const auto run = std::min(count, std::max(left, int64(1)));
+				accumulate_max(
+					peak,
+					Media::Audio::SamplesPeak(samples, int(run)));
+				sumbytes += run * each;
+				if (sumbytes >= countbytes) {
+					sumbytes -= countbytes;
+					peaks.push_back(peak);
+					peak = 0;
+				}
+				samples += run;
+				count -= run;
 			}
 		};
 		while (processed < countbytes) {
@@ -1767,11 +1831,14 @@ public:
 				continue;
 			}
 
-			auto sampleBytes = bytes::make_span(buffer);
 			if (fmt == AL_FORMAT_MONO8 || fmt == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, callback);
+				consume(
+					reinterpret_cast<const uchar*>(buffer.constData()),
+					buffer.size());
 			} else if (fmt == AL_FORMAT_MONO16 || fmt == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, callback);
+				consume(
+					reinterpret_cast<const int16*>(buffer.constData()),
+					buffer.size() / sizeof(int16));
 			}
 			processed += sampleSize() * samples;
 		}
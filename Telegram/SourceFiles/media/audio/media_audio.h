@@ -210,6 +210,7 @@ private:
 	class Track {
 	public:
 		static constexpr int kBuffersCount = 3;
+		static constexpr int kPreparedChunksCount = 2;
 
 		// Thread: Any. Must be locked: AudioMutex.
 		void reattach(AudioMsgId::Type type);
@@ -225,6 +226,12 @@ private:
 
 		int getNotQueuedBufferIndex();
 
+		// Thread: Any. Must be locked: AudioMutex.
+		void pushPreparedChunk(QByteArray &&samples, int64 count);
+		void queuePreparedChunks();
+		[[nodiscard]] bool preparedChunksFull() const;
+		[[nodiscard]] int64 preparedLength() const;
+
 		// Thread: Main. Must be locked: AudioMutex.
 		void setExternalData(std::unique_ptr<ExternalSoundData> data);
 		void changeSpeedEffect(float64 speed);
@@ -246,6 +253,14 @@ private:
 		int samplesCount[kBuffersCount] = { 0 };
 		QByteArray bufferSamples[kBuffersCount];
 
+		// Decoded ahead by the loader, queued by the fader
+		// as soon as some source buffer is processed.
+		struct PreparedChunk {
+			QByteArray samples;
+			int64 count = 0;
+		};
+		std::deque<PreparedChunk> preparedChunks;
+
 		struct Stream {
 			uint32 source = 0;
 			uint32 buffers[kBuffersCount] = { 0 };
@@ -406,6 +421,16 @@ TG_FORCE_INLINE uint16 ReadOneSample(int16 data) {
 	return qAbs(data);
 }
 
+// Written without branches, so that it is vectorized by the compiler.
+template <typename SampleType>
+[[nodiscard]] uint16 SamplesPeak(const SampleType *samples, int count) {
+	auto result = uint16(0);
+	for (auto i = 0; i != count; ++i) {
+		result = std::max(result, ReadOneSample(samples[i]));
+	}
+	return result;
+}
+
 template <typename SampleType, typename Callback>
 void IterateSamples(bytes::const_span bytes, Callback &&callback) {
 	auto samplesPointer = reinterpret_cast<const SampleType*>(bytes.data());
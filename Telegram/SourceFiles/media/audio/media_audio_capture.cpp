@@ -647,13 +647,17 @@ bool Instance::Inner::processFrame(int32 offset, int32 framesize) {
 	}
 
 	d->waveform.reserve(d->waveform.size() + (samplesCnt / d->waveformEach) + 1);
-	for (short *ptr = srcSamplesDataChannel, *end = ptr + samplesCnt; ptr != end; ++ptr) {
-		uint16 value = qAbs(*ptr);
-		if (d->waveformPeak < value) {
-			d->waveformPeak = value;
-		}
-		if (++d->waveformMod == d->waveformEach) {
-			d->waveformMod -= d->waveformEach;
+	for (short *ptr = srcSamplesDataChannel, *end = ptr + samplesCnt; ptr != end;) {
+		const auto run = std::min(
+			int64(end - ptr),
+			d->waveformEach - d->waveformMod);
+		accumulate_max(
+			d->waveformPeak,
+			Media::Audio::SamplesPeak(ptr, int(run)));
+		ptr += run;
+		d->waveformMod += run;
+		if (d->waveformMod == d->waveformEach) {
+			d->waveformMod = 0;
 			d->waveform.push_back(uchar(d->waveformPeak / 256));
 			d->waveformPeak = 0;
 		}
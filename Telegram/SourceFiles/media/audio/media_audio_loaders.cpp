@@ -237,7 +237,11 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 	if (samplesCount) {
 		track->ensureStreamCreated(type);
 
-		auto bufferIndex = track->getNotQueuedBufferIndex();
+		// Samples prepared earlier must be queued first.
+		track->queuePreparedChunks();
+		auto bufferIndex = track->preparedChunks.empty()
+			? track->getNotQueuedBufferIndex()
+			: -1;
 
 		if (!internal::audioCheckError()) {
 			setStoppedState(track, State::StoppedAtError);
@@ -245,19 +249,24 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 			return;
 		}
 
-		if (bufferIndex < 0) { // No free buffers, wait.
+		if (bufferIndex < 0 && track->preparedChunksFull()) {
+			// No free buffers, wait.
 			l->saveDecodedSamples(&samples, &samplesCount);
 			return;
 		} else if (l->forceToBuffer()) {
 			l->setForceToBuffer(false);
 		}
 
-		track->bufferSamples[bufferIndex] = samples;
-		track->samplesCount[bufferIndex] = samplesCount;
-		track->bufferedLength += samplesCount;
-		alBufferData(track->stream.buffers[bufferIndex], track->format, samples.constData(), samples.size(), track->frequency);
+		if (bufferIndex < 0) {
+			track->pushPreparedChunk(std::move(samples), samplesCount);
+		} else {
+			track->bufferSamples[bufferIndex] = samples;
+			track->samplesCount[bufferIndex] = samplesCount;
+			track->bufferedLength += samplesCount;
+			alBufferData(track->stream.buffers[bufferIndex], track->format, samples.constData(), samples.size(), track->frequency);
 
-		alSourceQueueBuffers(track->stream.source, 1, track->stream.buffers + bufferIndex);
+			alSourceQueueBuffers(track->stream.source, 1, track->stream.buffers + bufferIndex);
+		}
 
 		if (!internal::audioCheckError()) {
 			setStoppedState(track, State::StoppedAtError);
@@ -274,7 +283,9 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 
 	if (finished) {
 		track->loaded = true;
-		track->state.length = track->bufferedPosition + track->bufferedLength;
+		track->state.length = track->bufferedPosition
+			+ track->bufferedLength
+			+ track->preparedLength();
 		clear(type);
 	}
 
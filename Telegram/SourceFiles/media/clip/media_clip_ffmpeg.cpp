@@ -10,6 +10,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/file_location.h"
 #include "logs.h"
 
+#include <atomic>
+
 namespace Media {
 namespace Clip {
 namespace internal {
@@ -22,6 +24,15 @@ constexpr auto kMaxSendingArea = 3840 * 2160; // usual 4K
 // See https://github.com/telegramdesktop/tdesktop/issues/7225
 constexpr auto kAlignImageBy = 64;
 
+// Short loops are decoded once and then replayed from rendered frames.
+// The whole loop at the rendered size must fit, so the limit of a clip
+// is computed from its frame size and frames count.
+constexpr auto kMaxCachedDuration = crl::time(3000);
+constexpr auto kMaxCachedBytes = int64(32 * 1024 * 1024);
+constexpr auto kMaxCachedBytesTotal = int64(96 * 1024 * 1024);
+
+std::atomic<int64> CachedBytesTotal = 0;
+
 void alignedImageBufferCleanupHandler(void *data) {
 	auto buffer = static_cast<uchar*>(data);
 	delete[] buffer;
@@ -55,6 +66,9 @@ FFMpegReaderImplementation::FFMpegReaderImplementation(
 }
 
 ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
+	if (_cacheState == CacheState::Replaying) {
+		return replayCachedFrame();
+	}
 	do {
 		int res = avcodec_receive_frame(_codecContext, _frame.get());
 		if (res >= 0) {
@@ -74,6 +88,16 @@ ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
 				LOG(("Gif Error: Got EOF before a single frame was read!"));
 				return ReadResult::Error;
 			}
+			if (_cacheState == CacheState::Waiting) {
+				// Record from the loop start, the first frames of the
+				// first loop may be rendered before the size is known.
+				_cacheState = CacheState::Recording;
+			} else if (_cacheState == CacheState::Recording
+				&& !_cachedFrames.empty()) {
+				_cacheState = CacheState::Replaying;
+				_cachedIndex = -1;
+				return replayCachedFrame();
+			}
 
 			if ((res = avformat_seek_file(_fmtContext, _streamId, std::numeric_limits<int64_t>::min(), 0, std::numeric_limits<int64_t>::max(), 0)) < 0) {
 				if ((res = av_seek_frame(_fmtContext, _streamId, 0, AVSEEK_FLAG_BYTE)) < 0) {
@@ -143,6 +167,10 @@ ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
 }
 
 void FFMpegReaderImplementation::processReadFrame() {
+	if (_frameRead && _cacheState == CacheState::Recording) {
+		// Previous frame was skipped without rendering.
+		clearCachedFrames();
+	}
 	int64 duration = _frame->pkt_duration;
 	int64 framePts = _frame->pts;
 	crl::time frameMs = (framePts * 1000LL * _fmtContext->streams[_streamId]->time_base.num) / _fmtContext->streams[_streamId]->time_base.den;
@@ -164,6 +192,67 @@ void FFMpegReaderImplementation::processReadFrame() {
 	_frameTime += _currentFrameDelay;
 }
 
+auto FFMpegReaderImplementation::replayCachedFrame() -> ReadResult {
+	Expects(!_cachedFrames.empty());
+
+	_cachedIndex = (_cachedIndex + 1) % int(_cachedFrames.size());
+	const auto &frame = _cachedFrames[_cachedIndex];
+	_currentFrameDelay = frame.delay;
+	_frameMs = frame.frameMs;
+	_hadFrame = _frameRead = true;
+	_frameTime += _currentFrameDelay;
+	return ReadResult::Success;
+}
+
+void FFMpegReaderImplementation::cacheRenderedFrame(
+		const QImage &image,
+		bool alpha,
+		QSize size) {
+	const auto bytes = int64(image.sizeInBytes());
+	if (_cachedFrames.empty()) {
+		_cachedSize = size;
+		_cachedBytesLimit = bytes * expectedFramesCount() * 5 / 4;
+		if (_cachedBytesLimit > kMaxCachedBytes
+			|| (CachedBytesTotal + _cachedBytesLimit
+				> kMaxCachedBytesTotal)) {
+			clearCachedFrames();
+			return;
+		}
+	} else if (_cachedSize != size) {
+		clearCachedFrames();
+		return;
+	}
+	const auto total = CachedBytesTotal.fetch_add(bytes) + bytes;
+	_cachedBytes += bytes;
+	if (_cachedBytes > _cachedBytesLimit || total > kMaxCachedBytesTotal) {
+		clearCachedFrames();
+		return;
+	}
+	_cachedFrames.push_back({
+		.image = image,
+		.frameMs = _frameMs,
+		.delay = _currentFrameDelay,
+		.alpha = alpha,
+	});
+}
+
+int64 FFMpegReaderImplementation::expectedFramesCount() const {
+	const auto duration = durationMs();
+	const auto rate = _fmtContext->streams[_streamId]->avg_frame_rate;
+	if (rate.num > 0 && rate.den > 0) {
+		return duration * rate.num / (int64(rate.den) * 1000) + 1;
+	}
+	return duration / std::max(_currentFrameDelay, 1) + 1;
+}
+
+void FFMpegReaderImplementation::clearCachedFrames() {
+	CachedBytesTotal.fetch_sub(_cachedBytes);
+	_cachedBytes = 0;
+	_cachedBytesLimit = 0;
+	_cachedFrames.clear();
+	_cacheState = CacheState::None;
+}
+
 ReaderImplementation::ReadResult FFMpegReaderImplementation::readFramesTill(crl::time frameMs, crl::time systemMs) {
 	if (_frameRead && _frameTime > frameMs) {
 		return ReadResult::Success;
@@ -204,6 +293,25 @@ bool FFMpegReaderImplementation::renderFrame(QImage &to, bool &hasAlpha, const Q
 	Expects(_frameRead);
 	_frameRead = false;
 
+	if (_cacheState == CacheState::Replaying) {
+		const auto &frame = _cachedFrames[_cachedIndex];
+		hasAlpha = frame.alpha;
+		if (size == _cachedSize) {
+			to = frame.image;
+			return true;
+		}
+		// Size changed, the codec is still at the end of the clip,
+		// so we continue by decoding the next loop from the start.
+		to = size.isEmpty()
+			? frame.image
+			: frame.image.scaled(
+				size,
+				Qt::IgnoreAspectRatio,
+				Qt::SmoothTransformation);
+		clearCachedFrames();
+		return true;
+	}
+
 	if (!_width || !_height) {
 		_width = _frame->width;
 		_height = _frame->height;
@@ -255,6 +363,9 @@ bool FFMpegReaderImplementation::renderFrame(QImage &to, bool &hasAlpha, const Q
 
 	FFmpeg::ClearFrameMemory(_frame.get());
 
+	if (_cacheState == CacheState::Recording) {
+		cacheRenderedFrame(to, hasAlpha, size);
+	}
 	return true;
 }
 
@@ -359,6 +470,13 @@ bool FFMpegReaderImplementation::start(Mode mode, crl::time &positionMs) {
 		processPacket(std::move(packet));
 	}
 
+	const auto duration = durationMs();
+	if (_mode == Mode::Silent
+		&& positionMs <= 0
+		&& duration > 0
+		&& duration <= kMaxCachedDuration) {
+		_cacheState = CacheState::Waiting;
+	}
 	return true;
 }
 
@@ -420,6 +538,7 @@ QString FFMpegReaderImplementation::logData() const {
 }
 
 FFMpegReaderImplementation::~FFMpegReaderImplementation() {
+	clearCachedFrames();
 	if (_codecContext) avcodec_free_context(&_codecContext);
 	if (_swsContext) sws_freeContext(_swsContext);
 	if (_opened) {
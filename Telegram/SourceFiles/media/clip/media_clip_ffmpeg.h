@@ -51,6 +51,23 @@ private:
 	ReadResult readNextFrame();
 	void processReadFrame();
 
+	enum class CacheState {
+		None,
+		Waiting,
+		Recording,
+		Replaying,
+	};
+	struct CachedFrame {
+		QImage image;
+		crl::time frameMs = 0;
+		int delay = 0;
+		bool alpha = false;
+	};
+	[[nodiscard]] ReadResult replayCachedFrame();
+	void cacheRenderedFrame(const QImage &image, bool alpha, QSize size);
+	[[nodiscard]] int64 expectedFramesCount() const;
+	void clearCachedFrames();
+
 	enum class PacketResult {
 		Ok,
 		EndOfFile,
@@ -108,6 +125,13 @@ private:
 	crl::time _frameTime = 0;
 	crl::time _frameTimeCorrection = 0;
 
+	CacheState _cacheState = CacheState::None;
+	std::vector<CachedFrame> _cachedFrames;
+	QSize _cachedSize;
+	int64 _cachedBytes = 0;
+	int64 _cachedBytesLimit = 0;
+	int _cachedIndex = 0;
+
 };
 
 } // namespace internal
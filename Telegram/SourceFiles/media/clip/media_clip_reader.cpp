@@ -31,7 +31,7 @@ namespace Media {
 namespace Clip {
 namespace {
 
-constexpr auto kClipThreadsCount = 8;
+constexpr auto kClipThreadsCountMax = 8;
 constexpr auto kAverageGifSize = 320 * 240;
 constexpr auto kWaitBeforeGifPause = crl::time(200);
 
@@ -171,6 +171,16 @@ struct Worker {
 
 std::vector<std::unique_ptr<Worker>>  Workers;
 
+[[nodiscard]] int ClipThreadsCount() {
+	// Streaming video tracks decode on the crl pool, which is sized by
+	// the core count, so we leave half of the cores to it.
+	static const auto result = std::clamp(
+		QThread::idealThreadCount() / 2,
+		1,
+		kClipThreadsCountMax);
+	return result;
+}
+
 } // namespace
 
 Reader::Reader(
@@ -192,7 +202,7 @@ Reader::Reader(const QByteArray &data, Callback &&callback)
 }
 
 void Reader::init(const Core::FileLocation &location, const QByteArray &data) {
-	if (Workers.size() < kClipThreadsCount) {
+	if (int(Workers.size()) < ClipThreadsCount()) {
 		_threadIndex = Workers.size();
 		Workers.push_back(std::make_unique<Worker>());
 	} else {
@@ -869,25 +879,16 @@ void Manager::process() {
 		checkAllReaders = (_readers.size() > _readerPointers.size());
 	}
 
+	struct Due {
+		ReaderPrivate *reader = nullptr;
+		crl::time when = 0;
+	};
+	auto due = std::vector<Due>();
+	due.reserve(_readers.size());
 	for (auto i = _readers.begin(), e = _readers.end(); i != e;) {
 		ReaderPrivate *reader = i.key();
 		if (i.value() <= ms) {
-			ResultHandleState state = handleResult(reader, reader->process(ms), ms);
-			if (state == ResultHandleRemove) {
-				i = _readers.erase(i);
-				continue;
-			} else if (state == ResultHandleStop) {
-				_processingInThread = nullptr;
-				return;
-			}
-			ms = crl::now();
-			if (reader->_videoPausedAtMs) {
-				i.value() = ms + 86400 * 1000ULL;
-			} else if (reader->_nextFrameWhen && reader->_started) {
-				i.value() = reader->_nextFrameWhen;
-			} else {
-				i.value() = (ms + 86400 * 1000ULL);
-			}
+			due.push_back({ reader, i.value() });
 		} else if (checkAllReaders) {
 			QMutexLocker lock(&_readerPointersMutex);
 			auto it = constUnsafeFindReaderPointer(reader);
@@ -898,10 +899,39 @@ void Manager::process() {
 				continue;
 			}
 		}
-		if (!reader->_autoPausedGif && i.value() < minms) {
+		++i;
+	}
+
+	// Shown readers go before the auto paused ones,
+	// and among them the ones with the earliest frame deadline.
+	ranges::sort(due, [](const Due &a, const Due &b) {
+		return (a.reader->_autoPausedGif != b.reader->_autoPausedGif)
+			? b.reader->_autoPausedGif
+			: (a.when < b.when);
+	});
+	for (const auto &[reader, when] : due) {
+		ResultHandleState state = handleResult(reader, reader->process(ms), ms);
+		if (state == ResultHandleRemove) {
+			_readers.remove(reader);
+			continue;
+		} else if (state == ResultHandleStop) {
+			_processingInThread = nullptr;
+			return;
+		}
+		ms = crl::now();
+		auto &next = _readers[reader];
+		if (reader->_videoPausedAtMs) {
+			next = ms + 86400 * 1000ULL;
+		} else if (reader->_nextFrameWhen && reader->_started) {
+			next = reader->_nextFrameWhen;
+		} else {
+			next = (ms + 86400 * 1000ULL);
+		}
+	}
+	for (auto i = _readers.cbegin(), e = _readers.cend(); i != e; ++i) {
+		if (!i.key()->_autoPausedGif && i.value() < minms) {
 			minms = i.value();
 		}
-		++i;
 	}
 
 	ms = crl::now();
@@ -17,6 +17,7 @@ namespace {
 
 constexpr auto kMaxSingleReadAmount = 8 * 1024 * 1024;
 constexpr auto kMaxQueuedPackets = 1024;
+constexpr auto kMaxQueuedBytes = 16 * 1024 * 1024;
 
 [[nodiscard]] bool UnreliableFormatDuration(
 		not_null<AVFormatContext*> format,
@@ -210,6 +211,7 @@ Stream File::Context::initStream(
 			result.codec = nullptr;
 		}
 	}
+	result.bitrate = std::max(int64(info->codecpar->bit_rate), int64(0));
 	return result;
 }
 
@@ -252,6 +254,45 @@ void File::Context::seekToPosition(
 	return logFatal(qstr("av_seek_frame"), error);
 }
 
+void File::Context::sendSeekPoints(
+		not_null<AVFormatContext*> format,
+		const Stream &stream,
+		crl::time position) {
+	if (stream.duration == kDurationUnavailable
+		|| stream.duration == kTimeUnknown) {
+		return;
+	}
+	const auto info = format->streams[stream.index];
+	auto points = std::vector<Reader::SeekPoint>();
+	const auto add = [&](const AVIndexEntry *entry) {
+		if (entry
+			&& (entry->flags & AVINDEX_KEYFRAME)
+			&& entry->pos >= 0
+			&& entry->pos < _size) {
+			points.push_back({
+				.position = FFmpeg::PtsToTime(
+					entry->timestamp,
+					stream.timeBase),
+				.offset = int(entry->pos),
+			});
+		}
+	};
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+	const auto count = avformat_index_get_entries_count(info);
+	points.reserve(count);
+	for (auto i = 0; i != count; ++i) {
+		add(avformat_index_get_entry(info, i));
+	}
+#else // LIBAVFORMAT_VERSION_INT >= 58.78.100
+	points.reserve(info->nb_index_entries);
+	for (auto i = 0; i != info->nb_index_entries; ++i) {
+		add(&info->index_entries[i]);
+	}
+#endif // LIBAVFORMAT_VERSION_INT < 58.78.100
+	ranges::sort(points, ranges::less(), &Reader::SeekPoint::position);
+	_reader->setSeekPoints(std::move(points), stream.duration, position);
+}
+
 std::variant<FFmpeg::Packet, FFmpeg::AvErrorWrap> File::Context::readPacket() {
 	auto error = FFmpeg::AvErrorWrap();
 
@@ -302,7 +343,11 @@ void File::Context::start(crl::time position, bool hwAllow) {
 		sendFullInCache(true);
 	}
 	if (video.codec || audio.codec) {
-		seekToPosition(format.get(), video.codec ? video : audio, position);
+		const auto &stream = video.codec ? video : audio;
+		if (_reader->isRemoteLoader()) {
+			sendSeekPoints(format.get(), stream, position);
+		}
+		seekToPosition(format.get(), stream, position);
 	}
 	if (unroll()) {
 		return;
@@ -343,8 +388,10 @@ void File::Context::readNextPacket() {
 		if (i == end(_queuedPackets)) {
 			return;
 		}
+		_queuedBytes += packet->fields().size;
 		i->second.push_back(std::move(*packet));
-		if (i->second.size() == kMaxQueuedPackets) {
+		if (i->second.size() == kMaxQueuedPackets
+			|| _queuedBytes >= kMaxQueuedBytes) {
 			processQueuedPackets(SleepPolicy::Allowed);
 		}
 		Assert(i->second.size() < kMaxQueuedPackets);
@@ -383,6 +430,7 @@ void File::Context::handleEndOfFile() {
 
 void File::Context::processQueuedPackets(SleepPolicy policy) {
 	const auto more = _delegate->fileProcessPackets(_queuedPackets);
+	_queuedBytes = 0;
 	if (!more && policy == SleepPolicy::Allowed) {
 		do {
 			_reader->startSleep(&_semaphore);
@@ -476,6 +524,10 @@ void File::setLoaderPriority(int priority) {
 	_reader->setLoaderPriority(priority);
 }
 
+void File::prefetchPosition(crl::time position) {
+	_reader->prefetchPositionAsync(position);
+}
+
 File::~File() {
 	stop();
 }
@@ -37,6 +37,7 @@ public:
 
 	[[nodiscard]] bool isRemoteLoader() const;
 	void setLoaderPriority(int priority);
+	void prefetchPosition(crl::time position);
 
 	~File();
 
@@ -84,6 +85,10 @@ private:
 			not_null<AVFormatContext *> format,
 			const Stream &stream,
 			crl::time position);
+		void sendSeekPoints(
+			not_null<AVFormatContext *> format,
+			const Stream &stream,
+			crl::time position);
 
 		// TODO base::expected.
 		[[nodiscard]] auto readPacket()
@@ -97,6 +102,7 @@ private:
 		const not_null<Reader*> _reader;
 
 		base::flat_map<int, std::vector<FFmpeg::Packet>> _queuedPackets;
+		int64 _queuedBytes = 0;
 		int _offset = 0;
 		int _size = 0;
 		bool _failed = false;
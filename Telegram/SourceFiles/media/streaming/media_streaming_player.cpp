@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/streaming/media_streaming_video_track.h"
 #include "media/audio/media_audio.h" // for SupportsSpeedControl()
 #include "data/data_document.h" // for DocumentData::duration()
+#include "core/metrics.h"
 
 namespace Media {
 namespace Streaming {
@@ -21,6 +22,7 @@ namespace {
 constexpr auto kBufferFor = 3 * crl::time(1000);
 constexpr auto kLoadInAdvanceForRemote = 32 * crl::time(1000);
 constexpr auto kLoadInAdvanceForLocal = 5 * crl::time(1000);
+constexpr auto kMaxBytesInAdvance = int64(64 * 1024 * 1024);
 constexpr auto kMsFrequency = 1000; // 1000 ms per second.
 
 // If we played for 3 seconds and got stuck it looks like we're loading
@@ -146,6 +148,10 @@ void Player::setLoaderPriority(int priority) {
 	_file->setLoaderPriority(priority);
 }
 
+void Player::prefetchPosition(crl::time position) {
+	_file->prefetchPosition(position);
+}
+
 template <typename Track>
 void Player::trackReceivedTill(
 		const Track &track,
@@ -261,6 +267,9 @@ bool Player::fileReady(int headerSize, Stream &&video, Stream &&audio) {
 	if (mode != Mode::Video && mode != Mode::Both) {
 		video = Stream();
 	}
+	_audioPacketsBytes = PacketsBytes{ .bitrate = audio.bitrate };
+	_videoPacketsBytes = PacketsBytes{ .bitrate = video.bitrate };
+	_bytesPerSecond = (audio.bitrate + video.bitrate) / 8;
 	if (audio.duration == kDurationUnavailable) {
 		LOG(("Streaming Error: Audio stream with unknown duration."));
 		return false;
@@ -342,6 +351,10 @@ void Player::fileWaitingForData() {
 		return;
 	}
 	_waitingForData = true;
+	if (_stage == Stage::Started) {
+		static auto &Rebuffers = Core::Metrics::Counter("streaming.waits");
+		++Rebuffers;
+	}
 	if (_audio) {
 		_audio->waitForData();
 	}
@@ -376,6 +389,10 @@ bool Player::fileProcessPackets(
 			crl::on_main(&_sessionGuard, [=] {
 				audioReceivedTill(till);
 			});
+			countPacketsBytes(
+				_audioPacketsBytes,
+				list,
+				_audio->streamTimeBase());
 			_audio->process(base::take(list));
 		} else if (_video && _video->streamIndex() == index) {
 			//for (const auto &packet : list) {
@@ -396,6 +413,10 @@ bool Player::fileProcessPackets(
 			crl::on_main(&_sessionGuard, [=] {
 				videoReceivedTill(till);
 			});
+			countPacketsBytes(
+				_videoPacketsBytes,
+				list,
+				_video->streamTimeBase());
 			_video->process(base::take(list));
 		} else {
 			list.clear(); // Free non-needed packets.
@@ -472,6 +493,36 @@ int Player::durationByPacket(
 	return result;
 }
 
+void Player::countPacketsBytes(
+		PacketsBytes &counted,
+		const std::vector<FFmpeg::Packet> &list,
+		AVRational timeBase) {
+	const auto from = FFmpeg::PacketPosition(list.front(), timeBase);
+	if (counted.till == kTimeUnknown || from < counted.till) {
+		// Started or looped, count from the beginning.
+		counted.bytes = 0;
+		counted.from = from;
+	}
+	for (const auto &packet : list) {
+		counted.bytes += packet.fields().size;
+	}
+	counted.till = FFmpeg::PacketPosition(list.back(), timeBase);
+	_bytesPerSecond = BytesPerSecond(_audioPacketsBytes)
+		+ BytesPerSecond(_videoPacketsBytes);
+}
+
+int64 Player::BytesPerSecond(const PacketsBytes &counted) {
+	if (counted.bitrate > 0) {
+		return counted.bitrate / 8;
+	}
+	const auto duration = (counted.till != kTimeUnknown)
+		? (counted.till - counted.from)
+		: crl::time(0);
+	return (duration >= kMsFrequency)
+		? (counted.bytes * kMsFrequency / duration)
+		: 0;
+}
+
 void Player::setDurationByPackets() {
 	if (_loopingShift || _totalDuration != kDurationUnavailable) {
 		return;
@@ -501,6 +552,12 @@ void Player::provideStartInformation() {
 	} else {
 		_stage = Stage::Ready;
 
+		// Time from play() (start or seek) to the first ready frames.
+		static auto &Starts = Core::Metrics::Counter("streaming.starts");
+		static auto &Time = Core::Metrics::Counter("streaming.start_ms");
+		++Starts;
+		Time += crl::now() - _playRequestedAt;
+
 		if (_audio && _audioFinished) {
 			// Audio was stopped before it was ready.
 			_audio->stop();
@@ -544,6 +601,7 @@ void Player::play(const PlaybackOptions &options) {
 		_options.speed = 1.;
 	}
 	_stage = Stage::Initializing;
+	_playRequestedAt = crl::now();
 	_file->start(delegate(), _options.position, _options.hwAllowed);
 }
 
@@ -559,7 +617,19 @@ void Player::savePreviousReceivedTill(
 }
 
 crl::time Player::loadInAdvanceFor() const {
-	return _remoteLoader ? kLoadInAdvanceForRemote : kLoadInAdvanceForLocal;
+	const auto full = _remoteLoader
+		? kLoadInAdvanceForRemote
+		: kLoadInAdvanceForLocal;
+	const auto bytesPerSecond = _bytesPerSecond.load();
+	if (bytesPerSecond <= 0) {
+		return full;
+	}
+	// Packets read in advance are kept in memory until decoded, so we
+	// limit them by bytes for high bitrate files, still keeping enough
+	// to resume playback after waiting for kBufferFor.
+	const auto byBytes = crl::time(
+		kMaxBytesInAdvance * kMsFrequency / bytesPerSecond);
+	return std::min(full, std::max(byBytes, 2 * kBufferFor));
 }
 
 crl::time Player::computeTotalDuration() const {
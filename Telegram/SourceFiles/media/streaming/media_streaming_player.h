@@ -76,6 +76,7 @@ public:
 	bool markFrameShown();
 
 	void setLoaderPriority(int priority);
+	void prefetchPosition(crl::time position);
 
 	[[nodiscard]] Media::Player::TrackState prepareLegacyState() const;
 
@@ -138,8 +139,19 @@ private:
 		crl::time previousReceivedTill);
 	[[nodiscard]] crl::time loadInAdvanceFor() const;
 
+	struct PacketsBytes {
+		int64 bitrate = 0;
+		int64 bytes = 0;
+		crl::time from = kTimeUnknown;
+		crl::time till = kTimeUnknown;
+	};
 	template <typename Track>
 	int durationByPacket(const Track &track, const FFmpeg::Packet &packet);
+	void countPacketsBytes(
+		PacketsBytes &counted,
+		const std::vector<FFmpeg::Packet> &list,
+		AVRational timeBase);
+	[[nodiscard]] static int64 BytesPerSecond(const PacketsBytes &counted);
 
 	// Valid after fileReady call ends. Thread-safe.
 	[[nodiscard]] crl::time computeAudioDuration() const;
@@ -205,8 +217,12 @@ private:
 	std::optional<bool> _fullInCacheSinceStart;
 
 	crl::time _totalDuration = kTimeUnknown;
+	std::atomic<int64> _bytesPerSecond = 0;
+	PacketsBytes _audioPacketsBytes;
+	PacketsBytes _videoPacketsBytes;
 	crl::time _loopingShift = 0;
 	crl::time _previousReceivedTill = kTimeUnknown;
+	crl::time _playRequestedAt = 0; // For the "streaming.*" metrics.
 	std::atomic<int> _durationByPackets = 0;
 	int _durationByLastAudioPacket = 0;
 	int _durationByLastVideoPacket = 0;
@@ -11,6 +11,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/streaming/media_streaming_loader.h"
 #include "storage/cache/storage_cache_database.h"
 
+#include <mutex>
+
 namespace Media {
 namespace Streaming {
 namespace {
@@ -25,10 +27,114 @@ constexpr auto kSlicesInMemory = 2;
 
 // 1 MB of parts are requested from cloud ahead of reading demand.
 constexpr auto kPreloadPartsAhead = 8;
-constexpr auto kDownloaderRequestsLimit = 4;
+constexpr auto kDownloaderRequestsLimit = 8;
+
+// Likely seek targets are loaded at the 10% marks of the duration,
+// two parts from the keyframe before each mark.
+constexpr auto kPrefetchMarks = 10;
+constexpr auto kPrefetchPartsPerTarget = 2;
+constexpr auto kPrefetchOffsetsMax = 32;
 
 using PartsMap = base::flat_map<int, QByteArray>;
 
+class SlicesMemory final {
+public:
+	[[nodiscard]] static SlicesMemory &Instance();
+
+	void setLimit(int64 limit);
+	void use(not_null<Reader*> reader, int sliceIndex);
+	void release(not_null<Reader*> reader, int sliceIndex);
+	void release(not_null<Reader*> reader);
+	[[nodiscard]] bool shouldUnload(
+		not_null<Reader*> reader,
+		int sliceIndex);
+
+private:
+	struct Entry {
+		Reader *reader = nullptr;
+		int sliceIndex = 0;
+		uint64 lastUsed = 0;
+	};
+
+	std::mutex _mutex;
+	std::vector<Entry> _entries;
+	uint64 _counter = 0;
+	int _limit = int(kDefaultSlicesMemoryLimit / kInSlice);
+
+};
+
+SlicesMemory &SlicesMemory::Instance() {
+	static SlicesMemory result;
+	return result;
+}
+
+void SlicesMemory::setLimit(int64 limit) {
+	auto lock = std::lock_guard<std::mutex>(_mutex);
+	_limit = int(std::max(limit / kInSlice, int64(kSlicesInMemory)));
+}
+
+void SlicesMemory::use(not_null<Reader*> reader, int sliceIndex) {
+	auto lock = std::lock_guard<std::mutex>(_mutex);
+	const auto i = ranges::find_if(_entries, [&](const Entry &entry) {
+		return (entry.reader == reader) && (entry.sliceIndex == sliceIndex);
+	});
+	if (i != end(_entries)) {
+		i->lastUsed = ++_counter;
+		return;
+	}
+	_entries.push_back({ reader.get(), sliceIndex, ++_counter });
+	if (int(_entries.size()) <= _limit) {
+		return;
+	}
+
+	// Wake the readers holding the coldest slices so they unload them.
+	auto sorted = std::vector<Entry>(_entries);
+	const auto over = int(sorted.size()) - _limit;
+	ranges::nth_element(
+		sorted,
+		begin(sorted) + over - 1,
+		ranges::less(),
+		&Entry::lastUsed);
+	auto woken = base::flat_set<Reader*>();
+	for (auto j = begin(sorted), e = begin(sorted) + over; j != e; ++j) {
+		if (j->reader != reader && woken.emplace(j->reader).second) {
+			j->reader->wakeFromSleep();
+		}
+	}
+}
+
+void SlicesMemory::release(not_null<Reader*> reader, int sliceIndex) {
+	auto lock = std::lock_guard<std::mutex>(_mutex);
+	_entries.erase(ranges::remove_if(_entries, [&](const Entry &entry) {
+		return (entry.reader == reader) && (entry.sliceIndex == sliceIndex);
+	}), end(_entries));
+}
+
+void SlicesMemory::release(not_null<Reader*> reader) {
+	auto lock = std::lock_guard<std::mutex>(_mutex);
+	_entries.erase(
+		ranges::remove(_entries, reader.get(), &Entry::reader),
+		end(_entries));
+}
+
+bool SlicesMemory::shouldUnload(not_null<Reader*> reader, int sliceIndex) {
+	auto lock = std::lock_guard<std::mutex>(_mutex);
+	if (int(_entries.size()) <= _limit) {
+		return false;
+	}
+	const auto i = ranges::find_if(_entries, [&](const Entry &entry) {
+		return (entry.reader == reader) && (entry.sliceIndex == sliceIndex);
+	});
+	if (i == end(_entries)) {
+		return false;
+	}
+	const auto lastUsed = i->lastUsed;
+	const auto colder = ranges::count_if(_entries, [&](const Entry &entry) {
+		return (entry.lastUsed < lastUsed);
+	});
+	return (colder < int(_entries.size()) - _limit);
+}
+
 struct ParsedCacheEntry {
 	PartsMap parts;
 	std::optional<PartsMap> included;
@@ -332,8 +438,9 @@ auto Reader::Slice::offsetsFromLoader(int from, int till) const
 	return result;
 }
 
-Reader::Slices::Slices(int size, bool useCache)
-: _size(size) {
+Reader::Slices::Slices(not_null<Reader*> owner, int size, bool useCache)
+: _owner(owner)
+, _size(size) {
 	Expects(size > 0);
 
 	if (useCache) {
@@ -525,7 +632,7 @@ void Reader::Slices::processPart(
 	Expects(isFullInHeader() || (offset / kInSlice < _data.size()));
 
 	if (isFullInHeader()) {
-		_header.addPart(offset, bytes);
+		_header.addPart(offset, std::move(bytes));
 		checkSliceFullLoaded(0);
 		return;
 	} else if (_headerMode == HeaderMode::Unknown) {
@@ -630,6 +737,61 @@ auto Reader::Slices::fill(int offset, bytes::span buffer) -> FillResult {
 	return result;
 }
 
+auto Reader::Slices::prefetch(int from, int till) -> PrefetchResult {
+	Expects(from >= 0 && from < till);
+
+	using Flag = Slice::Flag;
+
+	auto result = PrefetchResult();
+	if (isFullInHeader() || _headerMode == HeaderMode::Unknown) {
+		// Small files are read fully, before the header is done.
+		result.done = true;
+		return result;
+	}
+	const auto index = from / kInSlice;
+	const auto shift = index * kInSlice;
+	till = std::min({ till, shift + kInSlice, _size });
+	if (from >= till) {
+		result.done = true;
+		return result;
+	}
+	auto &slice = _data[index];
+	if (_headerMode != HeaderMode::NoCache
+		&& !(slice.flags & Flag::LoadedFromCache)) {
+		if (!(slice.flags & Flag::LoadingFromCache)) {
+			slice.flags |= Flag::LoadingFromCache;
+			result.sliceNumberFromCache = index + 1;
+		}
+		return result;
+	}
+	const auto fromOffset = ((from - shift) / kPartSize) * kPartSize;
+	const auto tillOffset = ((till - shift + kPartSize - 1) / kPartSize)
+		* kPartSize;
+	auto missing = false;
+	for (const auto offset : slice.offsetsFromLoader(
+			fromOffset,
+			tillOffset).values()) {
+		result.offsetsFromLoader.add(offset + shift);
+		missing = true;
+	}
+	if (missing) {
+		return result;
+	}
+	result.done = true;
+
+	// Don't keep prefetched slices in memory, they wait in the cache.
+	if (index > 0
+		&& _headerMode != HeaderMode::NoCache
+		&& !ranges::contains(_usedSlices, index)) {
+		if (slice.flags & Flag::ChangedSinceCache) {
+			result.toCache = serializeAndUnloadSlice(index + 1);
+		} else {
+			unloadSlice(slice);
+		}
+	}
+	return result;
+}
+
 auto Reader::Slices::fillFromHeader(int offset, bytes::span buffer)
 -> FillResult {
 	auto result = FillResult();
@@ -684,6 +846,8 @@ bool Reader::Slices::readCacheForDownloaderRequired(int offset) {
 }
 
 void Reader::Slices::markSliceUsed(int sliceIndex) {
+	SlicesMemory::Instance().use(_owner, sliceIndex);
+
 	const auto i = ranges::find(_usedSlices, sliceIndex);
 	const auto end = _usedSlices.end();
 	if (i == end) {
@@ -703,12 +867,16 @@ int Reader::Slices::maxSliceSize(int sliceNumber) const {
 Reader::SerializedSlice Reader::Slices::serializeAndUnloadUnused() {
 	using Flag = Slice::Flag;
 
-	if (_headerMode == HeaderMode::Unknown
-		|| _usedSlices.size() <= kSlicesInMemory) {
+	if (_headerMode == HeaderMode::Unknown || _usedSlices.size() < 2) {
 		return {};
 	}
 	const auto purgeSlice = _usedSlices.front();
+	if (_usedSlices.size() <= kSlicesInMemory
+		&& !SlicesMemory::Instance().shouldUnload(_owner, purgeSlice)) {
+		return {};
+	}
 	_usedSlices.pop_front();
+	SlicesMemory::Instance().release(_owner, purgeSlice);
 	if (!(_data[purgeSlice].flags & Flag::LoadedFromCache)) {
 		// If the only data in this slice was from _header, just leave it.
 		return {};
@@ -759,7 +927,10 @@ Reader::SerializedSlice Reader::Slices::serializeAndUnloadSlice(
 		? 0
 		: FindNotLoadedStart(slice.parts, 0);
 	const auto continuous = (continuousTill > slice.parts.back().first);
-	if (continuous) {
+	if (continuous && count == 1) {
+		// Share the single part buffer instead of copying it.
+		result.data = slice.parts.front().second;
+	} else if (continuous) {
 		// All data is continuous.
 		result.data.reserve(count * kPartSize);
 		for (const auto &[offset, part] : slice.parts) {
@@ -851,7 +1022,7 @@ Reader::Reader(
 : _loader(std::move(loader))
 , _cache(cache)
 , _cacheHelper(cache ? InitCacheHelper(_loader->baseCacheKey()) : nullptr)
-, _slices(_loader->size(), _cacheHelper != nullptr) {
+, _slices(this, _loader->size(), _cacheHelper != nullptr) {
 	_loader->parts(
 	) | rpl::start_with_next([=](LoadedPart &&part) {
 		if (_attachedDownloader) {
@@ -863,6 +1034,9 @@ Reader::Reader(
 		if (const auto waiting = _waiting.load(std::memory_order_acquire)) {
 			_waiting.store(nullptr, std::memory_order_release);
 			waiting->release();
+		} else if (_prefetching) {
+			// Continue prefetching even if the playback is paused.
+			wakeFromSleep();
 		}
 	}, _lifetime);
 
@@ -874,6 +1048,19 @@ Reader::Reader(
 void Reader::startSleep(not_null<crl::semaphore*> wake) {
 	_sleeping.store(wake, std::memory_order_release);
 	processDownloaderRequests();
+	unloadColdSlices();
+	prefetchSeekTargets();
+}
+
+void Reader::unloadColdSlices() {
+	for (auto i = 0; i != kSlicesInMemory; ++i) {
+		auto toCache = _slices.serializeAndUnloadUnused();
+		if (_cacheHelper && toCache.number >= 0) {
+			const auto index = std::max(toCache.number, 1) - 1;
+			cancelLoadInRange(index * kInSlice, (index + 1) * kInSlice);
+			putToCache(std::move(toCache));
+		}
+	}
 }
 
 void Reader::wakeFromSleep() {
@@ -883,6 +1070,97 @@ void Reader::wakeFromSleep() {
 	}
 }
 
+void Reader::prefetchPositionAsync(crl::time position) {
+	_prefetchPositions.emplace(position);
+	wakeFromSleep();
+}
+
+void Reader::setSeekPoints(
+		std::vector<SeekPoint> &&points,
+		crl::time duration,
+		crl::time position) {
+	_seekPoints = std::move(points);
+	_prefetchOffsets.clear();
+	if (!isRemoteLoader() || _seekPoints.empty() || duration <= 0) {
+		return;
+	}
+	auto after = std::vector<int>();
+	auto before = std::vector<int>();
+	for (auto i = 1; i != kPrefetchMarks; ++i) {
+		const auto mark = duration * i / kPrefetchMarks;
+		const auto offset = seekPointOffset(mark);
+		if (offset < 0) {
+			continue;
+		}
+		auto &to = (mark > position) ? after : before;
+		if (!ranges::contains(to, offset)) {
+			to.push_back(offset);
+		}
+	}
+
+	// Marks following the start position go first.
+	_prefetchOffsets.insert(end(_prefetchOffsets), begin(after), end(after));
+	_prefetchOffsets.insert(
+		end(_prefetchOffsets),
+		rbegin(before),
+		rend(before));
+}
+
+int Reader::seekPointOffset(crl::time position) const {
+	const auto i = ranges::upper_bound(
+		_seekPoints,
+		position,
+		ranges::less(),
+		&SeekPoint::position);
+	return (i == begin(_seekPoints))
+		? -1
+		: ((i - 1)->offset / kPartSize) * kPartSize;
+}
+
+void Reader::prefetchSeekTargets() {
+	for (const auto position : _prefetchPositions.take()) {
+		const auto offset = seekPointOffset(position);
+		if (offset >= 0) {
+			const auto i = ranges::find(_prefetchOffsets, offset);
+			if (i != end(_prefetchOffsets)) {
+				_prefetchOffsets.erase(i);
+			}
+			_prefetchOffsets.push_front(offset);
+		}
+	}
+	while (_prefetchOffsets.size() > kPrefetchOffsetsMax) {
+		_prefetchOffsets.pop_back();
+	}
+
+	// Prefetch only while nothing that is really needed is loading.
+	checkForSomethingMoreReceived();
+	if (_streamingError || !_loadingOffsets.empty()) {
+		return;
+	}
+	while (!_prefetchOffsets.empty()) {
+		const auto from = _prefetchOffsets.front();
+		auto result = _slices.prefetch(
+			from,
+			std::min(from + kPrefetchPartsPerTarget * kPartSize, size()));
+		if (result.sliceNumberFromCache >= 0) {
+			readFromCache(result.sliceNumberFromCache);
+			_prefetching = true;
+			return;
+		} else if (!result.done) {
+			for (const auto offset : result.offsetsFromLoader.values()) {
+				loadAtOffset(offset);
+			}
+			_prefetching = true;
+			return;
+		}
+		if (_cacheHelper && result.toCache.number >= 0) {
+			putToCache(std::move(result.toCache));
+		}
+		_prefetchOffsets.pop_front();
+	}
+	_prefetching = false;
+}
+
 void Reader::stopSleep() {
 	_sleeping.store(nullptr, std::memory_order_release);
 }
@@ -1394,6 +1672,11 @@ void Reader::finalizeCache() {
 
 Reader::~Reader() {
 	finalizeCache();
+	SlicesMemory::Instance().release(this);
+}
+
+void SetSlicesMemoryLimit(int64 limit) {
+	SlicesMemory::Instance().setLimit(limit);
 }
 
 } // namespace Streaming
@@ -30,6 +30,11 @@ class Loader;
 struct LoadedPart;
 enum class Error;
 
+// Slices of all readers share this memory limit,
+// the least recently used slices are unloaded to cache first.
+inline constexpr auto kDefaultSlicesMemoryLimit = int64(128 * 1024 * 1024);
+void SetSlicesMemoryLimit(int64 limit);
+
 class Reader final : public base::has_weak_ptr {
 public:
 	enum class FillState : uchar {
@@ -38,6 +43,10 @@ public:
 		WaitingRemote,
 		Failed,
 	};
+	struct SeekPoint {
+		crl::time position = 0;
+		int offset = 0;
+	};
 
 	// Main thread.
 	explicit Reader(
@@ -59,6 +68,10 @@ public:
 	void headerDone();
 	[[nodiscard]] int headerSize() const;
 	[[nodiscard]] bool fullInCache() const;
+	void setSeekPoints(
+		std::vector<SeekPoint> &&points,
+		crl::time duration,
+		crl::time position);
 
 	// Thread safe.
 	void startSleep(not_null<crl::semaphore*> wake);
@@ -66,6 +79,7 @@ public:
 	void stopSleep();
 	void stopStreamingAsync();
 	void tryRemoveLoaderAsync();
+	void prefetchPositionAsync(crl::time position);
 
 	// Main thread.
 	void startStreaming();
@@ -110,6 +124,12 @@ private:
 		SerializedSlice toCache;
 		FillState state = FillState::WaitingRemote;
 	};
+	struct PrefetchResult {
+		StackIntVector<kLoadFromRemoteMax> offsetsFromLoader;
+		SerializedSlice toCache;
+		int sliceNumberFromCache = -1;
+		bool done = false;
+	};
 	struct Slice {
 		enum class Flag : uchar {
 			LoadingFromCache = 0x01,
@@ -143,7 +163,7 @@ private:
 
 	class Slices {
 	public:
-		Slices(int size, bool useCache);
+		Slices(not_null<Reader*> owner, int size, bool useCache);
 
 		void headerDone(bool fromCache);
 		[[nodiscard]] int headerSize() const;
@@ -161,6 +181,7 @@ private:
 		void processPart(int offset, QByteArray &&bytes);
 
 		[[nodiscard]] FillResult fill(int offset, bytes::span buffer);
+		[[nodiscard]] PrefetchResult prefetch(int from, int till);
 		[[nodiscard]] SerializedSlice unloadToCache();
 
 		[[nodiscard]] QByteArray partForDownloader(int offset) const;
@@ -192,6 +213,7 @@ private:
 		void checkSliceFullLoaded(int sliceNumber);
 		[[nodiscard]] bool checkFullInCache() const;
 
+		const not_null<Reader*> _owner;
 		std::vector<Slice> _data;
 		Slice _header;
 		std::deque<int> _usedSlices;
@@ -217,6 +239,10 @@ private:
 
 	FillState fillFromSlices(int offset, bytes::span buffer);
 
+	void prefetchSeekTargets();
+	void unloadColdSlices();
+	[[nodiscard]] int seekPointOffset(crl::time position) const;
+
 	void finalizeCache();
 
 	void processDownloaderRequests();
@@ -270,6 +296,14 @@ private:
 	base::thread_safe_queue<int> _downloaderOffsetRequests;
 	base::thread_safe_queue<int> _downloaderOffsetAcks;
 
+	// Streaming thread.
+	std::vector<SeekPoint> _seekPoints;
+	std::deque<int> _prefetchOffsets;
+
+	// Seek targets from the main thread, like seek bar hover.
+	base::thread_safe_queue<crl::time> _prefetchPositions;
+	std::atomic<bool> _prefetching = false;
+
 	rpl::lifetime _lifetime;
 
 };
@@ -17,6 +17,26 @@ namespace {
 
 constexpr auto kSkipInvalidDataPackets = 10;
 
+void CopyFrameContent(QImage &storage, const QImage &original) {
+	Expects(storage.size() == original.size());
+	Expects(storage.format() == original.format());
+
+	const auto perLine = original.width() * FFmpeg::kPixelBytesSize;
+	const auto fromPerLine = original.bytesPerLine();
+	const auto toPerLine = storage.bytesPerLine();
+	auto from = original.constBits();
+	auto to = storage.bits();
+	if (fromPerLine == perLine && toPerLine == perLine) {
+		memcpy(to, from, perLine * original.height());
+		return;
+	}
+	for (auto y = 0, height = original.height(); y != height; ++y) {
+		memcpy(to, from, perLine);
+		from += fromPerLine;
+		to += toPerLine;
+	}
+}
+
 } // namespace
 
 crl::time FramePosition(const Stream &stream) {
@@ -329,13 +349,23 @@ QImage PrepareByRequest(
 		storage = FFmpeg::CreateFrameStorage(outer);
 	}
 
-	if (alpha && request.keepAlpha) {
-		storage.fill(Qt::transparent);
-	}
+	// Same size without rotation and white background means the painter
+	// would only blit the frame, so we skip QPainter and copy the lines.
+	const auto copy = !rotation
+		&& (!alpha || request.keepAlpha)
+		&& (outer == original.size())
+		&& (request.resize.isEmpty() || request.resize == outer)
+		&& (storage.format() == original.format());
+	if (copy) {
+		CopyFrameContent(storage, original);
+	} else {
+		if (alpha && request.keepAlpha) {
+			storage.fill(Qt::transparent);
+		}
 
-	QPainter p(&storage);
-	PaintFrameContent(p, original, alpha, rotation, request);
-	p.end();
+		QPainter p(&storage);
+		PaintFrameContent(p, original, alpha, rotation, request);
+	}
 
 	ApplyFrameRounding(storage, request);
 	if (request.colored.alpha() != 0) {
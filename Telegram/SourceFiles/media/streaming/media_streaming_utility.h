@@ -34,6 +34,7 @@ struct Stream {
 	FFmpeg::FramePointer transferredFrame;
 	std::deque<FFmpeg::Packet> queue;
 	int invalidDataPackets = 0;
+	int64 bitrate = 0; // Bits per second from codec parameters, if known.
 
 	// Audio only.
 	int frequency = 0;
@@ -410,14 +410,17 @@ void GroupThumbs::Thumb::paint(
 		int y,
 		int outerWidth,
 		float64 progress) {
-	validateImage();
-
 	_opacity.update(progress, anim::linear);
 	_left.update(progress, anim::linear);
 	_width.update(progress, anim::linear);
 
 	const auto left = x + currentLeft();
 	const auto width = currentWidth();
+	if (left >= outerWidth || left + width <= 0) {
+		// Thumbs kept for the slide animation may be outside the viewer.
+		return;
+	}
+	validateImage();
 	const auto opacity = p.opacity();
 	p.setOpacity(_opacity.current() * opacity);
 	if (width == _fullWidth) {
@@ -99,6 +99,21 @@ void OverlayWidget::RendererSW::paintTransformedImage(
 		QRect rect,
 		int rotation) {
 	PainterHighQualityEnabler hq(*_p);
+	if (!rotation) {
+		// When zoomed in only a part of the image is visible,
+		// don't make the painter scale the whole image each frame.
+		const auto visible = rect.intersected(_clipOuter);
+		if (visible != rect && !visible.isEmpty() && !rect.isEmpty()) {
+			const auto xScale = image.width() / float64(rect.width());
+			const auto yScale = image.height() / float64(rect.height());
+			_p->drawImage(QRectF(visible), image, QRectF(
+				(visible.x() - rect.x()) * xScale,
+				(visible.y() - rect.y()) * yScale,
+				visible.width() * xScale,
+				visible.height() * yScale));
+			return;
+		}
+	}
 	if (UsePainterRotation(rotation)) {
 		if (rotation) {
 			_p->save();
@@ -98,6 +98,8 @@ namespace View {
 namespace {
 
 constexpr auto kPreloadCount = 3;
+constexpr auto kPreloadCountFast = 6;
+constexpr auto kFastFlipTimeout = crl::time(400);
 constexpr auto kMaxZoomLevel = 7; // x8
 constexpr auto kZoomToScreenLevel = 1024;
 constexpr auto kOverlayLoaderPriority = 2;
@@ -651,7 +653,11 @@ void OverlayWidget::setStaticContent(QImage image) {
 		&& image.format() != QImage::Format_RGB32) {
 		image = std::move(image).convertToFormat(kGood);
 	}
-	image.setDevicePixelRatio(cRetinaFactor());
+	if (image.isDetached()) {
+		// Renderers paint it into explicit rectangles, so don't deep copy
+		// a shared original image only to store the pixel ratio in it.
+		image.setDevicePixelRatio(cRetinaFactor());
+	}
 	_staticContent = std::move(image);
 	_staticContentTransparent = IsSemitransparent(_staticContent);
 }
@@ -2543,13 +2549,13 @@ void OverlayWidget::displayDocument(
 			if (_documentMedia->canBePlayed(_message)
 				&& initStreaming(startStreaming)) {
 			} else if (_document->isVideoFile()) {
-				_documentMedia->automaticLoad(fileOrigin(), _message);
+				_documentMedia->automaticLoad(fileOrigin(), _message, false);
 				initStreamingThumbnail();
 			} else if (_document->isTheme()) {
-				_documentMedia->automaticLoad(fileOrigin(), _message);
+				_documentMedia->automaticLoad(fileOrigin(), _message, false);
 				initThemePreview();
 			} else {
-				_documentMedia->automaticLoad(fileOrigin(), _message);
+				_documentMedia->automaticLoad(fileOrigin(), _message, false);
 				_document->saveFromDataSilent();
 				auto &location = _document->location(true);
 				if (location.accessEnable()) {
@@ -3200,6 +3206,7 @@ void OverlayWidget::restartAtSeekPosition(crl::time position) {
 void OverlayWidget::playbackControlsSeekProgress(crl::time position) {
 	Expects(_streamed != nullptr);
 
+	_streamed->instance.player().prefetchPosition(position);
 	if (!_streamed->instance.player().paused()
 		&& !_streamed->instance.player().finished()) {
 		_streamed->pausedBySeek = true;
@@ -3367,6 +3374,13 @@ void OverlayWidget::validatePhotoImage(Image *image, bool blurred) {
 	}
 	const auto use = flipSizeByRotation({ _width, _height })
 		* cIntRetinaFactor();
+	if (!blurred && !image->isNull() && image->size() == use) {
+		// Large photos are shown in their original size most of the time,
+		// skip the full-size scale and the QPixmap round-trip for them.
+		setStaticContent(image->original());
+		_blurred = false;
+		return;
+	}
 	setStaticContent(image->pixNoCache(
 		use,
 		{ .options = (blurred ? Images::Option::Blur : Images::Option()) }
@@ -4213,8 +4227,19 @@ void OverlayWidget::preloadData(int delta) {
 	if (!_index) {
 		return;
 	}
+	auto count = kPreloadCount;
+	if (delta) {
+		// Look further ahead while the user flips quickly in one direction.
+		const auto now = crl::now();
+		if (_lastPreloadDelta == delta
+			&& now - _lastPreloadTime < kFastFlipTimeout) {
+			count = kPreloadCountFast;
+		}
+		_lastPreloadDelta = delta;
+		_lastPreloadTime = now;
+	}
 	auto from = *_index + (delta ? -delta : -1);
-	auto till = *_index + (delta ? delta * kPreloadCount : 1);
+	auto till = *_index + (delta ? delta * count : 1);
 	if (from > till) std::swap(from, till);
 
 	auto photos = base::flat_set<std::shared_ptr<Data::PhotoMedia>>();
@@ -4224,14 +4249,21 @@ void OverlayWidget::preloadData(int delta) {
 		if (auto photo = std::get_if<not_null<PhotoData*>>(&entity.data)) {
 			const auto [i, ok] = photos.emplace((*photo)->createMediaView());
 			(*i)->wanted(Data::PhotoSize::Small, fileOrigin(entity));
-			(*photo)->load(fileOrigin(entity), LoadFromCloudOrLocal, true);
+			(*photo)->load(
+				fileOrigin(entity),
+				LoadFromCloudOrLocal,
+				true,
+				(index != *_index));
 		} else if (auto document = std::get_if<not_null<DocumentData*>>(
 				&entity.data)) {
 			const auto [i, ok] = documents.emplace(
 				(*document)->createMediaView());
 			(*i)->thumbnailWanted(fileOrigin(entity));
 			if (!(*i)->canBePlayed(entity.item)) {
-				(*i)->automaticLoad(fileOrigin(entity), entity.item);
+				(*i)->automaticLoad(
+					fileOrigin(entity),
+					entity.item,
+					(index != *_index));
 			}
 		}
 	}
@@ -20,6 +20,9 @@ namespace {
 
 std::atomic<int> GlobalConnectionCounter/* = 0*/;
 
+// Enough for a 512KB file part with all the headers.
+constexpr auto kMaxSparePacketInts = (512 + 4) * 1024 / sizeof(mtpPrime);
+
 } // namespace
 
 ConnectionPointer::ConnectionPointer() = default;
@@ -85,8 +88,9 @@ ConnectionPointer::~ConnectionPointer() {
 mtpBuffer AbstractConnection::prepareSecurePacket(
 		uint64 keyId,
 		MTPint128 msgKey,
-		uint32 size) const {
-	auto result = mtpBuffer();
+		uint32 size) {
+	auto result = base::take(_sparePacket);
+	result.resize(0);
 	constexpr auto kTcpPrefixInts = 2;
 	constexpr auto kAuthKeyIdPosition = kTcpPrefixInts;
 	constexpr auto kAuthKeyIdInts = 2;
@@ -104,6 +108,12 @@ mtpBuffer AbstractConnection::prepareSecurePacket(
 	return result;
 }
 
+void AbstractConnection::releasePacket(mtpBuffer &&buffer) {
+	if (buffer.capacity() <= kMaxSparePacketInts) {
+		_sparePacket = std::move(buffer);
+	}
+}
+
 gsl::span<const mtpPrime> AbstractConnection::parseNotSecureResponse(
 		const mtpBuffer &buffer) const {
 	const auto answer = buffer.data();
@@ -119,7 +119,7 @@ public:
 	[[nodiscard]] mtpBuffer prepareSecurePacket(
 		uint64 keyId,
 		MTPint128 msgKey,
-		uint32 size) const;
+		uint32 size);
 
 	[[nodiscard]] gsl::span<const mtpPrime> parseNotSecureResponse(
 		const mtpBuffer &buffer) const;
@@ -158,10 +158,15 @@ protected:
 	[[nodiscard]] std::optional<MTPResPQ> readPQFakeReply(
 		const mtpBuffer &buffer) const;
 
+	// Packet contents were already copied to the socket,
+	// the buffer can be reused by the next prepareSecurePacket().
+	void releasePacket(mtpBuffer &&buffer);
+
 private:
 	[[nodiscard]] uint32 extendedNotSecurePadding() const;
 
 	uint64 _sentEncryptedWithKeyId = 0;
+	mtpBuffer _sparePacket;
 
 };
 
@@ -20,6 +20,8 @@ namespace {
 constexpr auto kPacketSizeMax = int(0x01000000 * sizeof(mtpPrime));
 constexpr auto kFullConnectionTimeout = 8 * crl::time(1000);
 constexpr auto kSmallBufferSize = 256 * 1024;
+constexpr auto kLargeBufferStep = 64 * 1024;
+constexpr auto kKeepLargeBufferSize = 2 * 1024 * 1024;
 constexpr auto kMinPacketBuffer = 256;
 constexpr auto kConnectionStartPrefixSize = 64;
 
@@ -268,16 +270,21 @@ void TcpConnection::ensureAvailableInBuffer(int amount) {
 	if (amount <= _smallBuffer.size()) {
 		if (_usingLargeBuffer) {
 			bytes::copy(_smallBuffer, read);
-			_usingLargeBuffer = false;
-			_largeBuffer.clear();
+			releaseLargeBuffer();
 		} else {
 			bytes::move(_smallBuffer, read);
 		}
 	} else if (amount <= _largeBuffer.size()) {
-		Assert(_usingLargeBuffer);
-		bytes::move(_largeBuffer, read);
+		if (_usingLargeBuffer) {
+			bytes::move(_largeBuffer, read);
+		} else {
+			bytes::copy(_largeBuffer, read);
+			_usingLargeBuffer = true;
+		}
 	} else {
-		auto enough = bytes::vector(amount);
+		// Round up, so that the following file parts fit in it as well.
+		const auto steps = (amount + kLargeBufferStep - 1) / kLargeBufferStep;
+		auto enough = bytes::vector(steps * kLargeBufferStep);
 		bytes::copy(enough, read);
 		_largeBuffer = std::move(enough);
 		_usingLargeBuffer = true;
@@ -285,6 +292,13 @@ void TcpConnection::ensureAvailableInBuffer(int amount) {
 	_offsetBytes = 0;
 }
 
+void TcpConnection::releaseLargeBuffer() {
+	_usingLargeBuffer = false;
+	if (_largeBuffer.size() > kKeepLargeBufferSize) {
+		_largeBuffer = bytes::vector();
+	}
+}
+
 void TcpConnection::socketRead() {
 	Expects(_leftBytes > 0 || !_usingLargeBuffer);
 
@@ -293,6 +307,11 @@ void TcpConnection::socketRead() {
 		error(kErrorCodeOther);
 		return;
 	}
+	if (!_receiveStream.valid()) {
+		CONNECTION_LOG_ERROR("Data received before the connection start");
+		error(kErrorCodeOther);
+		return;
+	}
 
 	if (_smallBuffer.empty()) {
 		_smallBuffer.resize(kSmallBufferSize);
@@ -309,7 +328,7 @@ void TcpConnection::socketRead() {
 		const auto readCount = _socket->read(free.subspan(0, readLimit));
 		if (readCount > 0) {
 			const auto read = free.subspan(0, readCount);
-			aesCtrEncrypt(read, _receiveKey, &_receiveState);
+			_receiveStream.encrypt(read);
 			CONNECTION_LOG_INFO(u"Read %1 bytes"_q.arg(readCount));
 
 			_readBytes += readCount;
@@ -322,8 +341,7 @@ void TcpConnection::socketRead() {
 						return;
 					}
 
-					_usingLargeBuffer = false;
-					_largeBuffer.clear();
+					releaseLargeBuffer();
 					_offsetBytes = _readBytes = 0;
 				} else {
 					CONNECTION_LOG_INFO(
@@ -439,8 +457,9 @@ void TcpConnection::sendData(mtpBuffer &&buffer) {
 	const auto bytes = _protocol->finalizePacket(buffer);
 	CONNECTION_LOG_INFO(u"TCP Info: write packet %1 bytes."_q
 		.arg(bytes.size()));
-	aesCtrEncrypt(bytes, _sendKey, &_sendState);
+	_sendStream.encrypt(bytes);
 	_socket->write(connectionStartPrefix, bytes);
+	releasePacket(std::move(buffer));
 }
 
 bytes::const_span TcpConnection::prepareConnectionStartPrefix(
@@ -461,11 +480,10 @@ bytes::const_span TcpConnection::prepareConnectionStartPrefix(
 	} while (!_socket->isGoodStartNonce(nonce));
 
 	// prepare encryption key/iv
-	_protocol->prepareKey(
-		bytes::make_span(_sendKey),
-		nonce.subspan(8, CTRState::KeySize));
-	bytes::copy(
-		bytes::make_span(_sendState.ivec),
+	auto key = bytes::array<CTRState::KeySize>();
+	_protocol->prepareKey(key, nonce.subspan(8, CTRState::KeySize));
+	_sendStream = CTRStream(
+		key,
 		nonce.subspan(8 + CTRState::KeySize, CTRState::IvecSize));
 
 	// prepare decryption key/iv
@@ -473,11 +491,9 @@ bytes::const_span TcpConnection::prepareConnectionStartPrefix(
 	const auto reversed = bytes::make_span(reversedBytes);
 	bytes::copy(reversed, nonce.subspan(8, reversed.size()));
 	std::reverse(reversed.begin(), reversed.end());
-	_protocol->prepareKey(
-		bytes::make_span(_receiveKey),
-		reversed.subspan(0, CTRState::KeySize));
-	bytes::copy(
-		bytes::make_span(_receiveState.ivec),
+	_protocol->prepareKey(key, reversed.subspan(0, CTRState::KeySize));
+	_receiveStream = CTRStream(
+		key,
 		reversed.subspan(CTRState::KeySize, CTRState::IvecSize));
 
 	// write protocol and dc ids
@@ -487,7 +503,7 @@ bytes::const_span TcpConnection::prepareConnectionStartPrefix(
 	*dcId = _protocolDcId;
 
 	bytes::copy(buffer, nonce.subspan(0, 56));
-	aesCtrEncrypt(nonce, _sendKey, &_sendState);
+	_sendStream.encrypt(nonce);
 	bytes::copy(buffer.subspan(56), nonce.subspan(56));
 
 	return buffer;
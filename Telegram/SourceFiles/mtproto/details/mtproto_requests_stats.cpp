@@ -0,0 +1,76 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "mtproto/details/mtproto_requests_stats.h"
+
+namespace MTP::details {
+
+void RequestsStats::sent(
+		mtpRequestId requestId,
+		mtpTypeId type,
+		ShiftedDcId shiftedDcId,
+		int bytes) {
+	_pending[requestId] = Pending{
+		.key = { .type = type, .shiftedDcId = shiftedDcId },
+		.sent = crl::now(),
+		.bytes = bytes,
+	};
+}
+
+void RequestsStats::retried(mtpRequestId requestId) {
+	const auto i = _pending.find(requestId);
+	if (i != end(_pending)) {
+		++i->second.retries;
+	}
+}
+
+void RequestsStats::finished(mtpRequestId requestId, int bytes, bool failed) {
+	const auto i = _pending.find(requestId);
+	if (i == end(_pending)) {
+		return;
+	}
+	const auto &pending = i->second;
+	const auto latency = std::max(crl::now() - pending.sent, crl::time(0));
+	auto &histogram = _histograms[pending.key];
+	histogram.latency.add(latency);
+	if (failed) {
+		++histogram.failed;
+	}
+	histogram.retries += pending.retries;
+	histogram.sentBytes += pending.bytes;
+	histogram.receivedBytes += bytes;
+	_pending.erase(i);
+}
+
+void RequestsStats::forget(mtpRequestId requestId) {
+	_pending.remove(requestId);
+}
+
+QString RequestsStats::dump() const {
+	auto result = QStringList();
+	result.push_back("method dc count failed retries "
+		"avg_ms p50_ms p90_ms p99_ms max_ms sent_bytes received_bytes");
+	for (const auto &[key, histogram] : _histograms) {
+		result.push_back(u"0x%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11 %12"_q
+			.arg(uint32(key.type), 8, 16, QChar('0'))
+			.arg(key.shiftedDcId)
+			.arg(histogram.latency.count)
+			.arg(histogram.failed)
+			.arg(histogram.retries)
+			.arg(histogram.latency.average())
+			.arg(histogram.latency.percentile(50))
+			.arg(histogram.latency.percentile(90))
+			.arg(histogram.latency.percentile(99))
+			.arg(histogram.latency.max)
+			.arg(histogram.sentBytes)
+			.arg(histogram.receivedBytes));
+	}
+	result.push_back(u"pending %1"_q.arg(_pending.size()));
+	return result.join('\n');
+}
+
+} // namespace MTP::details
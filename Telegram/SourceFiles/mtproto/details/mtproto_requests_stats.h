@@ -0,0 +1,64 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/flat_map.h"
+#include "mtproto/details/mtproto_stats_histogram.h"
+
+#include <crl/crl_time.h>
+
+namespace MTP::details {
+
+// Latency, sizes and retries of finished requests by method and by dc.
+// Used only from the main thread, so there are no locks.
+class RequestsStats final {
+public:
+	void sent(
+		mtpRequestId requestId,
+		mtpTypeId type,
+		ShiftedDcId shiftedDcId,
+		int bytes);
+	void retried(mtpRequestId requestId);
+	void finished(mtpRequestId requestId, int bytes, bool failed);
+	void forget(mtpRequestId requestId);
+
+	[[nodiscard]] QString dump() const;
+
+private:
+	// Bucket i has latencies in [2^(i-1), 2^i) ms, the last is unbounded.
+	static constexpr auto kBucketsCount = 18;
+
+	struct Key {
+		mtpTypeId type = 0;
+		ShiftedDcId shiftedDcId = 0;
+
+		friend inline bool operator<(const Key &a, const Key &b) {
+			return std::tie(a.type, a.shiftedDcId)
+				< std::tie(b.type, b.shiftedDcId);
+		}
+	};
+	struct Pending {
+		Key key;
+		crl::time sent = 0;
+		int bytes = 0;
+		int retries = 0;
+	};
+	struct Histogram {
+		Log2Histogram<kBucketsCount> latency;
+		int64 failed = 0;
+		int64 retries = 0;
+		int64 sentBytes = 0;
+		int64 receivedBytes = 0;
+	};
+
+	base::flat_map<mtpRequestId, Pending> _pending;
+	base::flat_map<Key, Histogram> _histograms;
+
+};
+
+} // namespace MTP::details
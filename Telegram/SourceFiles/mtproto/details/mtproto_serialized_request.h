@@ -92,6 +92,7 @@ public:
 	mtpRequestId requestId = 0;
 	bool needsLayer = false;
 	bool forceSendInContainer = false;
+	bool shareIdentical = false;
 
 };
 
@@ -0,0 +1,58 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <array>
+
+namespace MTP::details {
+
+// Shared by the requests stats and the app paint stats.
+// Bucket i has values in [2^(i-1), 2^i), the last one is unbounded.
+template <int BucketsCount>
+struct Log2Histogram {
+	std::array<int64, BucketsCount> buckets = { { 0 } };
+	int64 count = 0;
+	int64 sum = 0;
+	int64 max = 0;
+
+	void add(int64 value) {
+		value = std::max(value, int64(0));
+		++buckets[BucketIndex(value)];
+		++count;
+		sum += value;
+		max = std::max(max, value);
+	}
+
+	[[nodiscard]] int64 average() const {
+		return sum / std::max(count, int64(1));
+	}
+
+	[[nodiscard]] int64 percentile(int percent) const {
+		const auto till = (count * percent + 99) / 100;
+		auto counted = int64(0);
+		for (auto i = 0; i != BucketsCount; ++i) {
+			counted += buckets[i];
+			if (counted >= till) {
+				// Upper bound of the bucket, the real value is less.
+				return std::min(int64(1) << i, max);
+			}
+		}
+		return max;
+	}
+
+	[[nodiscard]] static int BucketIndex(int64 value) {
+		auto result = 0;
+		while (value > 0 && result + 1 < BucketsCount) {
+			value >>= 1;
+			++result;
+		}
+		return result;
+	}
+};
+
+} // namespace MTP::details
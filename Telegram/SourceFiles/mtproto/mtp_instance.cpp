@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtp_instance.h"
 
 #include "mtproto/details/mtproto_dcenter.h"
+#include "mtproto/details/mtproto_requests_stats.h"
 #include "mtproto/details/mtproto_rsa_public_key.h"
 #include "mtproto/special_config_request.h"
 #include "mtproto/session.h"
@@ -38,6 +39,24 @@ using namespace details;
 
 std::atomic<int> GlobalAtomicRequestId = 0;
 
+[[nodiscard]] QByteArray SharedRequestKey(
+		ShiftedDcId shiftedDcId,
+		const SerializedRequest &request) {
+	const auto body = SerializedRequest::kMessageBodyPosition;
+	const auto ints = int(request->size()) - body;
+	Assert(ints > 0);
+
+	auto result = QByteArray();
+	result.reserve(sizeof(shiftedDcId) + ints * sizeof(mtpPrime));
+	result.append(
+		reinterpret_cast<const char*>(&shiftedDcId),
+		sizeof(shiftedDcId));
+	result.append(
+		reinterpret_cast<const char*>(request->constData() + body),
+		ints * sizeof(mtpPrime));
+	return result;
+}
+
 } // namespace
 
 namespace details {
@@ -134,8 +153,14 @@ public:
 		ResponseHandler &&callbacks);
 	SerializedRequest getRequest(mtpRequestId requestId);
 	[[nodiscard]] bool hasCallback(mtpRequestId requestId) const;
+	void preparseResponse(Response &response) const;
 	void processCallback(const Response &response);
 	void processUpdate(const Response &message);
+	[[nodiscard]] QString dumpRequestsStats() const;
+	void finishShared(const Response &response);
+	[[nodiscard]] bool cancelShared(mtpRequestId requestId);
+	void clearShared(ShiftedDcId shiftedDcId);
+	void resendShared(mtpRequestId requestId);
 
 	void onStateChange(ShiftedDcId shiftedDcId, int32 state);
 	void onSessionReset(ShiftedDcId shiftedDcId);
@@ -273,6 +298,12 @@ private:
 	mutable QMutex _dependentRequestsLock;
 
 	std::map<mtpRequestId, int> _requestsDelays;
+	RequestsStats _requestsStats;
+
+	// Identical requests waiting for the response of the first one.
+	base::flat_map<QByteArray, mtpRequestId> _sharedRequests;
+	base::flat_map<mtpRequestId, QByteArray> _sharedKeys;
+	base::flat_map<mtpRequestId, std::vector<mtpRequestId>> _sharedFollowers;
 
 	std::set<mtpRequestId> _badGuestDcRequests;
 
@@ -642,7 +673,7 @@ void Instance::Private::ping() {
 }
 
 void Instance::Private::cancel(mtpRequestId requestId) {
-	if (!requestId) return;
+	if (!requestId || cancelShared(requestId)) return;
 
 	DEBUG_LOG(("MTP Info: Cancel request %1.").arg(requestId));
 	const auto shiftedDcId = queryRequestByDc(requestId);
@@ -665,6 +696,104 @@ void Instance::Private::cancel(mtpRequestId requestId) {
 	_parserMap.erase(requestId);
 }
 
+bool Instance::Private::cancelShared(mtpRequestId requestId) {
+	const auto i = _sharedFollowers.find(requestId);
+	if (i != end(_sharedFollowers) && !i->second.empty()) {
+		// Others still wait for that response, only drop the handler.
+		DEBUG_LOG(("MTP Info: Cancel shared request %1.").arg(requestId));
+		_requestsStats.forget(requestId);
+		QMutexLocker locker(&_parserMapLock);
+		_parserMap.erase(requestId);
+		return true;
+	} else if (i != end(_sharedFollowers)) {
+		_sharedFollowers.erase(i);
+	}
+	if (const auto j = _sharedKeys.find(requestId); j != end(_sharedKeys)) {
+		// Nobody waits for it, identical requests should be sent again.
+		_sharedRequests.remove(j->second);
+		_sharedKeys.erase(j);
+		return false;
+	}
+	for (auto &[leaderId, followers] : _sharedFollowers) {
+		const auto i = ranges::find(followers, requestId);
+		if (i != end(followers)) {
+			followers.erase(i);
+			break;
+		}
+	}
+	return false;
+}
+
+void Instance::Private::finishShared(const Response &response) {
+	const auto requestId = response.requestId;
+	if (const auto i = _sharedKeys.find(requestId); i != end(_sharedKeys)) {
+		_sharedRequests.remove(i->second);
+		_sharedKeys.erase(i);
+	}
+	const auto i = _sharedFollowers.find(requestId);
+	if (i == end(_sharedFollowers)) {
+		return;
+	}
+	const auto followers = std::move(i->second);
+	_sharedFollowers.erase(i);
+	const auto failed = response.reply.isEmpty()
+		|| (response.reply[0] == mtpc_rpc_error);
+	for (const auto followerId : followers) {
+		if (failed) {
+			// Errors may need a resend and custom handling that differs
+			// for each request, so send the followers on their own.
+			resendShared(followerId);
+			continue;
+		}
+		auto copy = response;
+		copy.requestId = followerId;
+		processCallback(copy);
+	}
+}
+
+void Instance::Private::resendShared(mtpRequestId requestId) {
+	const auto request = getRequest(requestId);
+	const auto signedDcId = queryRequestByDc(requestId);
+	if (!request || !signedDcId) {
+		LOG(("MTP Error: could not find shared request %1 for resending"
+			).arg(requestId));
+		processCallback(Response{ .requestId = requestId });
+		return;
+	}
+	DEBUG_LOG(("MTP Info: resending shared request %1.").arg(requestId));
+	request->shareIdentical = false;
+	getSession(qAbs(*signedDcId))->sendPrepared(request, 0);
+}
+
+void Instance::Private::clearShared(ShiftedDcId shiftedDcId) {
+	auto leaders = std::vector<mtpRequestId>();
+	for (const auto &[leaderId, key] : _sharedKeys) {
+		const auto signedDcId = queryRequestByDc(leaderId);
+		if (signedDcId && qAbs(*signedDcId) == shiftedDcId) {
+			leaders.push_back(leaderId);
+		}
+	}
+	for (const auto leaderId : leaders) {
+		const auto i = _sharedKeys.find(leaderId);
+		_sharedRequests.remove(i->second);
+		_sharedKeys.erase(i);
+
+		const auto j = _sharedFollowers.find(leaderId);
+		if (j == end(_sharedFollowers)) {
+			continue;
+		}
+		// The response won't come from the killed session.
+		const auto followers = std::move(j->second);
+		_sharedFollowers.erase(j);
+		for (const auto followerId : followers) {
+			DEBUG_LOG(("MTP Info: Drop shared request %1.").arg(followerId));
+			unregisterRequest(followerId);
+			QMutexLocker locker(&_parserMapLock);
+			_parserMap.erase(followerId);
+		}
+	}
+}
+
 // result < 0 means waiting for such count of ms.
 int32 Instance::Private::state(mtpRequestId requestId) {
 	if (requestId > 0) {
@@ -1010,6 +1139,13 @@ void Instance::Private::sendRequest(
 	const auto realShiftedDcId = session->getDcWithShift();
 	const auto signedDcId = toMainDc ? -realShiftedDcId : realShiftedDcId;
 	registerRequest(requestId, signedDcId);
+	_requestsStats.sent(
+		requestId,
+		(request->size() > SerializedRequest::kMessageBodyPosition
+			? mtpTypeId((*request)[SerializedRequest::kMessageBodyPosition])
+			: mtpTypeId(0)),
+		realShiftedDcId,
+		request->size() * sizeof(mtpPrime));
 
 	if (afterRequestId) {
 		request->after = getRequest(afterRequestId);
@@ -1017,6 +1153,20 @@ void Instance::Private::sendRequest(
 	request->lastSentTime = crl::now();
 	request->needsLayer = needsLayer;
 
+	if (request->shareIdentical && !afterRequestId) {
+		auto key = SharedRequestKey(signedDcId, request);
+		const auto i = _sharedRequests.find(key);
+		if (i != end(_sharedRequests)) {
+			DEBUG_LOG(("MTP Info: request %1 shares the response of %2."
+				).arg(requestId
+				).arg(i->second));
+			_sharedFollowers[i->second].push_back(requestId);
+			return;
+		}
+		_sharedRequests.emplace(key, requestId);
+		_sharedKeys.emplace(requestId, std::move(key));
+	}
+
 	session->sendPrepared(request, msCanWait);
 }
 
@@ -1031,6 +1181,7 @@ void Instance::Private::unregisterRequest(mtpRequestId requestId) {
 	DEBUG_LOG(("MTP Info: unregistering request %1.").arg(requestId));
 
 	_requestsDelays.erase(requestId);
+	_requestsStats.forget(requestId);
 
 	{
 		QWriteLocker locker(&_requestMapLock);
@@ -1114,6 +1265,19 @@ bool Instance::Private::hasCallback(mtpRequestId requestId) const {
 	return (it != _parserMap.cend());
 }
 
+void Instance::Private::preparseResponse(Response &response) const {
+	auto parse = ParseHandler();
+	{
+		QMutexLocker locker(&_parserMapLock);
+		const auto it = _parserMap.find(response.requestId);
+		if (it == _parserMap.cend() || !it->second.parse) {
+			return;
+		}
+		parse = it->second.parse;
+	}
+	response.parsed = parse(response.reply);
+}
+
 void Instance::Private::processCallback(const Response &response) {
 	const auto requestId = response.requestId;
 	ResponseHandler handler;
@@ -1128,6 +1292,8 @@ void Instance::Private::processCallback(const Response &response) {
 		}
 	}
 	if (handler.done || handler.fail) {
+		const auto responseBytes = int(
+			response.reply.size() * sizeof(mtpPrime));
 		const auto handleError = [&](const Error &error) {
 			DEBUG_LOG(("RPC Info: "
 				"error received, code %1, type %2, description: %3").arg(
@@ -1135,8 +1301,11 @@ void Instance::Private::processCallback(const Response &response) {
 					error.type(),
 					error.description()));
 			if (rpcErrorOccured(response, handler, error)) {
+				_requestsStats.finished(requestId, responseBytes, true);
 				unregisterRequest(requestId);
+				finishShared(response);
 			} else {
+				_requestsStats.retried(requestId);
 				QMutexLocker locker(&_parserMapLock);
 				_parserMap.emplace(requestId, std::move(handler));
 			}
@@ -1156,19 +1325,26 @@ void Instance::Private::processCallback(const Response &response) {
 						"RESPONSE_PARSE_FAILED",
 						"Error parse failed.")));
 		} else {
+			_requestsStats.finished(requestId, responseBytes, false);
 			if (handler.done && !handler.done(response)) {
 				handleError(Error::Local(
 					"RESPONSE_PARSE_FAILED",
 					"Response parse failed."));
 			}
 			unregisterRequest(requestId);
+			finishShared(response);
 		}
 	} else {
 		DEBUG_LOG(("RPC Info: parser not found for %1").arg(requestId));
 		unregisterRequest(requestId);
+		finishShared(response);
 	}
 }
 
+QString Instance::Private::dumpRequestsStats() const {
+	return _requestsStats.dump();
+}
+
 void Instance::Private::processUpdate(const Response &message) {
 	if (_updatesHandler) {
 		_updatesHandler(message);
@@ -1592,6 +1768,7 @@ void Instance::Private::scheduleSessionDestroy(ShiftedDcId shiftedDcId) {
 	if (i == _sessions.cend()) {
 		return;
 	}
+	clearShared(shiftedDcId);
 	i->second->kill();
 	_sessionsToDestroy.push_back(std::move(i->second));
 	_sessions.erase(i);
@@ -2001,6 +2178,10 @@ bool Instance::hasCallback(mtpRequestId requestId) const {
 	return _private->hasCallback(requestId);
 }
 
+void Instance::preparseResponse(Response &response) const {
+	_private->preparseResponse(response);
+}
+
 void Instance::processCallback(const Response &response) {
 	_private->processCallback(response);
 }
@@ -2009,6 +2190,10 @@ void Instance::processUpdate(const Response &message) {
 	_private->processUpdate(message);
 }
 
+QString Instance::dumpRequestsStats() const {
+	return _private->dumpRequestsStats();
+}
+
 bool Instance::rpcErrorOccured(
 		const Response &response,
 		const FailHandler &onFail,
@@ -115,8 +115,12 @@ public:
 	void onSessionReset(ShiftedDcId shiftedDcId);
 
 	[[nodiscard]] bool hasCallback(mtpRequestId requestId) const;
+
+	// Called from the session thread, reads the result in advance.
+	void preparseResponse(Response &response) const;
 	void processCallback(const Response &response);
 	void processUpdate(const Response &message);
+	[[nodiscard]] QString dumpRequestsStats() const;
 
 	// return true if need to clean request data
 	bool rpcErrorOccured(
@@ -178,6 +182,27 @@ public:
 			afterRequestId);
 	}
 
+	// While an identical request to the same dc waits for the response
+	// this one doesn't go to the network and gets the same response.
+	template <typename Request>
+	mtpRequestId sendShared(
+			const Request &request,
+			ResponseHandler &&callbacks,
+			ShiftedDcId shiftedDcId = 0,
+			crl::time msCanWait = 0) {
+		const auto requestId = details::GetNextRequestId();
+		auto serialized = details::SerializedRequest::Serialize(request);
+		serialized->shareIdentical = true;
+		sendSerialized(
+			requestId,
+			std::move(serialized),
+			std::move(callbacks),
+			shiftedDcId,
+			msCanWait,
+			0);
+		return requestId;
+	}
+
 	template <typename Request>
 	mtpRequestId sendProtocolMessage(
 			ShiftedDcId shiftedDcId,
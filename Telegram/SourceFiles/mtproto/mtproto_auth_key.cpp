@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/openssl_help.h"
 
+#include <openssl/evp.h>
 #include <QtCore/QDataStream>
 
 namespace MTP {
@@ -186,4 +187,61 @@ void aesCtrEncrypt(bytes::span data, const void *key, CTRState *state) {
 		(block128_f)AES_encrypt);
 }
 
+CTRStream::CTRStream(bytes::const_span key, bytes::const_span ivec)
+: _context(EVP_CIPHER_CTX_new()) {
+	Expects(key.size() == CTRState::KeySize);
+	Expects(ivec.size() == CTRState::IvecSize);
+
+	if (!_context) {
+		LOG(("MTP Error: Could not create EVP cipher context."));
+		return;
+	}
+	const auto result = EVP_EncryptInit_ex(
+		_context,
+		EVP_aes_256_ctr(),
+		nullptr,
+		reinterpret_cast<const uchar*>(key.data()),
+		reinterpret_cast<const uchar*>(ivec.data()));
+	if (result != 1) {
+		LOG(("MTP Error: Could not init AES-CTR cipher context."));
+		destroy();
+	}
+}
+
+CTRStream::CTRStream(CTRStream &&other) noexcept
+: _context(base::take(other._context)) {
+}
+
+CTRStream &CTRStream::operator=(CTRStream &&other) noexcept {
+	if (this != &other) {
+		destroy();
+		_context = base::take(other._context);
+	}
+	return *this;
+}
+
+CTRStream::~CTRStream() {
+	destroy();
+}
+
+bool CTRStream::valid() const {
+	return (_context != nullptr);
+}
+
+void CTRStream::encrypt(bytes::span data) {
+	Expects(_context != nullptr);
+
+	const auto buffer = reinterpret_cast<uchar*>(data.data());
+	const auto size = int(data.size());
+	auto written = 0;
+	EVP_EncryptUpdate(_context, buffer, &written, buffer, size);
+	Assert(written == size);
+}
+
+void CTRStream::destroy() {
+	if (const auto context = base::take(_context)) {
+		EVP_CIPHER_CTX_free(context);
+	}
+}
+
 } // namespace MTP
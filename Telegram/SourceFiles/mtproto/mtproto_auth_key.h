@@ -11,6 +11,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <array>
 #include <memory>
 
+struct evp_cipher_ctx_st;
+
 namespace MTP {
 
 class AuthKey {
@@ -122,4 +124,23 @@ struct CTRState {
 };
 void aesCtrEncrypt(bytes::span data, const void *key, CTRState *state);
 
+// ctr stream used inplace, keeps the expanded key between calls
+class CTRStream {
+public:
+	CTRStream() = default;
+	CTRStream(bytes::const_span key, bytes::const_span ivec);
+	CTRStream(CTRStream &&other) noexcept;
+	CTRStream &operator=(CTRStream &&other) noexcept;
+	~CTRStream();
+
+	[[nodiscard]] bool valid() const;
+	void encrypt(bytes::span data);
+
+private:
+	void destroy();
+
+	evp_cipher_ctx_st *_context = nullptr;
+
+};
+
 } // namespace MTP
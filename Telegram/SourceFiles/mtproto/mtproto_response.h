@@ -58,14 +58,19 @@ struct Response {
 	mtpBuffer reply;
 	mtpMsgId outerMsgId = 0;
 	mtpRequestId requestId = 0;
+
+	// Result already read from reply on the session thread, if any.
+	std::shared_ptr<void> parsed;
 };
 
 using DoneHandler = FnMut<bool(const Response&)>;
 using FailHandler = Fn<bool(const Error&, const Response&)>;
+using ParseHandler = Fn<std::shared_ptr<void>(const mtpBuffer&)>;
 
 struct ResponseHandler {
 	DoneHandler done;
 	FailHandler fail;
+	ParseHandler parse;
 };
 
 } // namespace MTP
@@ -36,6 +36,24 @@ class Sender {
 		static constexpr bool IsCallable
 			= rpl::details::is_callable_plain_v<Args...>;
 
+		template <typename Result>
+		[[nodiscard]] static std::shared_ptr<Result> ParseResult(
+				const mtpBuffer &reply) {
+			auto result = std::make_shared<Result>();
+			auto from = reply.constData();
+			if (!result->read(from, from + reply.size())) {
+				return nullptr;
+			}
+			return result;
+		}
+
+		template <typename Result>
+		[[nodiscard]] static ParseHandler MakeParseHandler() {
+			return [](const mtpBuffer &reply) -> std::shared_ptr<void> {
+				return ParseResult<Result>(reply);
+			};
+		}
+
 		template <typename Result, typename Handler>
 		[[nodiscard]] DoneHandler MakeDoneHandler(
 				not_null<Sender*> sender,
@@ -45,11 +63,16 @@ class Sender {
 				auto onstack = std::move(handler);
 				sender->senderRequestHandled(response.requestId);
 
-				auto result = Result();
-				auto from = response.reply.constData();
-				if (!result.read(from, from + response.reply.size())) {
+				auto parsed = std::static_pointer_cast<const Result>(
+					response.parsed);
+				if (!parsed) {
+					parsed = ParseResult<Result>(response.reply);
+				}
+				if (!parsed) {
 					return false;
-				} else if (!onstack) {
+				}
+				const auto &result = *parsed;
+				if (!onstack) {
 					return true;
 				} else if constexpr (IsCallable<
 						Handler,
@@ -136,6 +159,9 @@ class Sender {
 		void setDoneHandler(DoneHandler &&handler) noexcept {
 			_done = std::move(handler);
 		}
+		void setParseHandler(ParseHandler &&handler) noexcept {
+			_parse = std::move(handler);
+		}
 		template <typename Handler>
 		void setFailHandler(Handler &&handler) noexcept {
 			_fail = std::forward<Handler>(handler);
@@ -146,6 +172,9 @@ class Sender {
 		void setAfter(mtpRequestId requestId) noexcept {
 			_afterRequestId = requestId;
 		}
+		void setShareIdentical() noexcept {
+			_shareIdentical = true;
+		}
 
 		ShiftedDcId takeDcId() const noexcept {
 			return _dcId;
@@ -156,6 +185,9 @@ class Sender {
 		DoneHandler takeOnDone() noexcept {
 			return std::move(_done);
 		}
+		ParseHandler takeOnParse() noexcept {
+			return std::move(_parse);
+		}
 		FailHandler takeOnFail() {
 			return v::match(_fail, [&](auto &value) {
 				return MakeFailHandler(
@@ -167,6 +199,9 @@ class Sender {
 		mtpRequestId takeAfter() const noexcept {
 			return _afterRequestId;
 		}
+		bool takeShareIdentical() const noexcept {
+			return _shareIdentical;
+		}
 
 		not_null<Sender*> sender() const noexcept {
 			return _sender;
@@ -180,6 +215,7 @@ class Sender {
 		ShiftedDcId _dcId = 0;
 		crl::time _canWait = 0;
 		DoneHandler _done;
+		ParseHandler _parse;
 		std::variant<
 			FailPlainHandler,
 			FailErrorHandler,
@@ -187,6 +223,7 @@ class Sender {
 			FailFullHandler> _fail;
 		FailSkipPolicy _failSkipPolicy = FailSkipPolicy::Simple;
 		mtpRequestId _afterRequestId = 0;
+		bool _shareIdentical = false;
 
 	};
 
@@ -226,6 +263,7 @@ public:
 				mtpRequestId requestId)> callback) {
 			setDoneHandler(
 				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setParseHandler(MakeParseHandler<Result>());
 			return *this;
 		}
 		[[nodiscard]] SpecificRequestBuilder &done(
@@ -234,12 +272,14 @@ public:
 				const Response &response)> callback) {
 			setDoneHandler(
 				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setParseHandler(MakeParseHandler<Result>());
 			return *this;
 		}
 		[[nodiscard]] SpecificRequestBuilder &done(
 				FnMut<void()> callback) {
 			setDoneHandler(
 				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setParseHandler(MakeParseHandler<Result>());
 			return *this;
 		}
 		[[nodiscard]] SpecificRequestBuilder &done(
@@ -247,6 +287,7 @@ public:
 				const typename Request::ResponseType &result)> callback) {
 			setDoneHandler(
 				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setParseHandler(MakeParseHandler<Result>());
 			return *this;
 		}
 
@@ -287,15 +328,29 @@ public:
 			setAfter(requestId);
 			return *this;
 		}
+		[[nodiscard]] SpecificRequestBuilder &shareIdentical() noexcept {
+			setShareIdentical();
+			return *this;
+		}
 
 		mtpRequestId send() {
-			const auto id = sender()->_instance->send(
-				_request,
-				takeOnDone(),
-				takeOnFail(),
-				takeDcId(),
-				takeCanWait(),
-				takeAfter());
+			auto handler = ResponseHandler{
+				.done = takeOnDone(),
+				.fail = takeOnFail(),
+				.parse = takeOnParse(),
+			};
+			const auto id = (takeShareIdentical() && !takeAfter())
+				? sender()->_instance->sendShared(
+					_request,
+					std::move(handler),
+					takeDcId(),
+					takeCanWait())
+				: sender()->_instance->send(
+					_request,
+					std::move(handler),
+					takeDcId(),
+					takeCanWait(),
+					takeAfter());
 			registerRequest(id);
 			return id;
 		}
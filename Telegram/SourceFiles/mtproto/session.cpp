@@ -16,6 +16,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace MTP {
 namespace details {
+namespace {
+
+// Don't hold delayed requests once they fill a good sized container.
+constexpr auto kMaxDelayedSendBytes = 16 * 1024;
+
+} // namespace
 
 SessionOptions::SessionOptions(
 	const QString &systemLangCode,
@@ -325,6 +331,7 @@ void Session::needToResumeAndSend() {
 		DEBUG_LOG(("Session Info: resuming session dcWithShift %1").arg(_shiftedDcId));
 		start();
 	}
+	_delayedSendBytes = 0;
 	const auto captured = _private;
 	const auto ping = base::take(_ping);
 	InvokeQueued(captured, [=] {
@@ -431,8 +438,12 @@ void Session::sendPrepared(
 
 	DEBUG_LOG(("MTP Info: added, requestId %1").arg(request->requestId));
 	if (msCanWait >= 0) {
+		const auto bytes = int64(request.messageSize()) * sizeof(mtpPrime);
 		InvokeQueued(this, [=] {
-			sendAnything(msCanWait);
+			_delayedSendBytes += bytes;
+			sendAnything((_delayedSendBytes >= kMaxDelayedSendBytes)
+				? 0
+				: msCanWait);
 		});
 	}
 }
@@ -208,6 +208,7 @@ private:
 
 	crl::time _msSendCall = 0;
 	crl::time _msWait = 0;
+	int64 _delayedSendBytes = 0;
 
 	bool _ping = false;
 
@@ -28,7 +28,10 @@ namespace details {
 namespace {
 
 constexpr auto kIntSize = static_cast<int>(sizeof(mtpPrime));
+constexpr auto kPreparseResponsePrimes = 16 * 1024 / kIntSize;
 constexpr auto kWaitForBetterTimeout = crl::time(2000);
+constexpr auto kNoBetterHintTimeout = 10 * 60 * crl::time(1000);
+constexpr auto kNoBetterHintConnects = 8;
 constexpr auto kMinConnectedTimeout = crl::time(1000);
 constexpr auto kMaxConnectedTimeout = crl::time(8000);
 constexpr auto kMinReceiveTimeout = crl::time(4000);
@@ -968,6 +971,10 @@ void SessionPrivate::retryByTimer() {
 void SessionPrivate::restartNow() {
 	_retryTimeout = 1;
 	_retryTimer.cancel();
+
+	// Timeouts grown on the previous network shouldn't delay the new one.
+	_waitForConnected = kMinConnectedTimeout;
+	_waitForReceived = kMinReceiveTimeout;
 	restart();
 }
 
@@ -1820,13 +1827,23 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 		}
 		const auto requestId = wasSent(requestMsgId);
 		if (requestId && requestId != mtpRequestId(0xFFFFFFFF)) {
-			// Save rpc_result for processing in the main thread.
-			QWriteLocker locker(_sessionData->haveReceivedMutex());
-			_sessionData->haveReceivedMessages().push_back({
+			auto received = Response{
 				.reply = std::move(response),
 				.outerMsgId = info.outerMsgId,
 				.requestId = requestId,
-			});
+			};
+
+			// Large results are read here, so that the main thread
+			// only has to invoke the handler.
+			if (typeId != mtpc_rpc_error
+				&& received.reply.size() >= kPreparseResponsePrimes) {
+				_instance->preparseResponse(received);
+			}
+
+			// Save rpc_result for processing in the main thread.
+			QWriteLocker locker(_sessionData->haveReceivedMutex());
+			_sessionData->haveReceivedMessages().push_back(
+				std::move(received));
 		} else {
 			DEBUG_LOG(("RPC Info: requestId not found for msgId %1").arg(requestMsgId));
 		}
@@ -2275,13 +2292,27 @@ void SessionPrivate::onConnected(
 	const auto j = ranges::find_if(
 		_testConnections,
 		[&](const TestConnection &test) { return test.priority > my; });
-	if (j != end(_testConnections)) {
+	if (_noBetterThanPriority >= 0
+		&& (_noBetterThanPriorityTill <= crl::now()
+			|| _noBetterThanPriorityConnects >= kNoBetterHintConnects)) {
+		// The network could've changed, try the better ones again.
+		_noBetterThanPriority = -1;
+	}
+	if (j != end(_testConnections)
+		&& (_noBetterThanPriority < 0 || my < _noBetterThanPriority)) {
 		DEBUG_LOG(("MTP Info: connection %1 succeed, waiting for %2.").arg(
 			i->data->tag(),
 			j->data->tag()));
 		_waitForBetterTimer.callOnce(kWaitForBetterTimeout);
 	} else {
-		DEBUG_LOG(("MTP Info: connection through IPv4 succeed."));
+		if (j != end(_testConnections)) {
+			DEBUG_LOG(("MTP Info: connection %1 succeed, "
+				"better ones failed last time.").arg(i->data->tag()));
+			++_noBetterThanPriorityConnects;
+		} else {
+			DEBUG_LOG(("MTP Info: connection through IPv4 succeed."));
+			_noBetterThanPriority = -1;
+		}
 		_waitForBetterTimer.cancel();
 		_connection = std::move(i->data);
 		_testConnections.clear();
@@ -2319,6 +2350,9 @@ void SessionPrivate::confirmBestConnection() {
 	DEBUG_LOG(("MTP Info: can't connect through better, using %1."
 		).arg(i->data->tag()));
 
+	_noBetterThanPriority = i->priority;
+	_noBetterThanPriorityTill = crl::now() + kNoBetterHintTimeout;
+	_noBetterThanPriorityConnects = 0;
 	_connection = std::move(i->data);
 	_testConnections.clear();
 
@@ -204,6 +204,9 @@ private:
 	base::Timer _waitForConnectedTimer;
 	base::Timer _waitForReceivedTimer;
 	base::Timer _waitForBetterTimer;
+	int _noBetterThanPriority = -1; // Last wait for better failed.
+	crl::time _noBetterThanPriorityTill = 0;
+	int _noBetterThanPriorityConnects = 0;
 	crl::time _waitForReceived = 0;
 	crl::time _waitForConnected = 0;
 	crl::time _firstSentAt = -1;
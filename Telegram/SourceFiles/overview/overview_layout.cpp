@@ -327,9 +327,19 @@ void Photo::paint(Painter &p, const QRect &clip, TextSelection selection, const
 			_goodLoaded = good;
 			_pix = QPixmap();
 			if (_goodLoaded) {
-				setPixFrom(_dataMedia->image(Data::PhotoSize::Large)
-					? _dataMedia->image(Data::PhotoSize::Large)
-					: _dataMedia->image(Data::PhotoSize::Thumbnail));
+				// Scaling the large image down to a grid cell is wasteful
+				// when the thumbnail is already big enough for the cell.
+				const auto size = _width * cIntRetinaFactor();
+				const auto thumbnail = _dataMedia->image(
+					Data::PhotoSize::Thumbnail);
+				const auto large = _dataMedia->image(Data::PhotoSize::Large);
+				setPixFrom((thumbnail
+					&& (!large
+						|| std::min(
+							thumbnail->width(),
+							thumbnail->height()) >= size))
+					? thumbnail
+					: large);
 			} else if (const auto small = _dataMedia->image(
 					Data::PhotoSize::Small)) {
 				setPixFrom(small);
@@ -35,6 +35,7 @@ constexpr auto kService = "org.freedesktop.Notifications"_cs;
 constexpr auto kObjectPath = "/org/freedesktop/Notifications"_cs;
 constexpr auto kInterface = kService;
 constexpr auto kPropertiesInterface = "org.freedesktop.DBus.Properties"_cs;
+constexpr auto kImageCacheLimit = 16;
 
 using namespace base::Platform;
 
@@ -397,6 +398,25 @@ Glib::ustring GetImageKey(const QVersionNumber &specificationVersion) {
 	return "icon_data";
 }
 
+[[nodiscard]] QImage ReadImageForHint(const QString &imagePath) {
+	// Userpic files from CachedUserpics are never rewritten in place,
+	// so we can skip the PNG decoding for consecutive notifications.
+	static auto Cache = base::flat_map<QString, QImage>();
+	if (const auto i = Cache.find(imagePath); i != end(Cache)) {
+		return i->second;
+	} else if (Cache.size() >= kImageCacheLimit) {
+		Cache.clear();
+	}
+	const auto original = QImage(imagePath);
+	auto result = original.hasAlphaChannel()
+		? original.convertToFormat(QImage::Format_RGBA8888)
+		: original.convertToFormat(QImage::Format_RGB888);
+	if (!result.isNull()) {
+		Cache.emplace(imagePath, result);
+	}
+	return result;
+}
+
 class NotificationData final : public base::has_weak_ptr {
 public:
 	using NotificationId = Window::Notifications::Manager::NotificationId;
@@ -679,12 +699,7 @@ void NotificationData::setImage(const QString &imagePath) {
 		return;
 	}
 
-	const auto image = [&] {
-		const auto original = QImage(imagePath);
-		return original.hasAlphaChannel()
-			? original.convertToFormat(QImage::Format_RGBA8888)
-			: original.convertToFormat(QImage::Format_RGB888);
-	}();
+	const auto image = ReadImageForHint(imagePath);
 
 	if (image.isNull()) {
 		return;
@@ -23,7 +23,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtp_instance.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "core/file_utilities.h"
+#include "core/metrics.h"
 #include "core/update_checker.h"
+#include "history/view/history_view_paint_stats.h"
+#include "ui/image/image.h"
 #include "window/themes/window_theme.h"
 #include "window/themes/window_theme_editor.h"
 #include "window/window_session_controller.h"
@@ -73,6 +76,17 @@ using SessionController = Window::SessionController;
 	return result;
 }
 
+void WriteDumpAndShow(const QString &name, const QString &dump) {
+	const auto path = cWorkingDir() + name;
+	auto f = QFile(path);
+	if (!f.open(QIODevice::WriteOnly) || f.write(dump.toUtf8()) < 0) {
+		Ui::Toast::Show("Could not write " + name + " :(");
+		return;
+	}
+	f.close();
+	File::ShowInFolder(path);
+}
+
 auto GenerateCodes() {
 	auto codes = std::map<QString, Fn<void(SessionController*)>>();
 	codes.emplace(qsl("debugmode"), [](SessionController *window) {
@@ -87,6 +101,38 @@ auto GenerateCodes() {
 	codes.emplace(qsl("viewlogs"), [](SessionController *window) {
 		File::ShowInFolder(cWorkingDir() + "log.txt");
 	});
+	codes.emplace(qsl("mtpstats"), [](SessionController *window) {
+		if (!window) {
+			return;
+		}
+		WriteDumpAndShow(
+			"mtp_stats.txt",
+			window->session().mtp().dumpRequestsStats());
+	});
+	codes.emplace(qsl("paintstats"), [](SessionController *window) {
+		if (!HistoryView::PaintStatsEnabled()) {
+			HistoryView::SetPaintStatsEnabled(true);
+			Ui::Toast::Show("Paint stats enabled, type again to save.");
+			return;
+		}
+		const auto stats = HistoryView::DumpPaintStats();
+		HistoryView::SetPaintStatsEnabled(false);
+		WriteDumpAndShow("paint_stats.txt", stats);
+	});
+	codes.emplace(qsl("metrics"), [](SessionController *window) {
+		WriteDumpAndShow("metrics.txt", Core::Metrics::Dump());
+	});
+	codes.emplace(qsl("imagestats"), [](SessionController *window) {
+		const auto stats = Images::CurrentDecodedStats();
+		const auto mb = [](int64 bytes) {
+			return QString::number(bytes / (1024. * 1024.), 'f', 1);
+		};
+		Ui::show(Ui::MakeInformBox(QString(
+			"Decoded images: %1, %2 MB.\nCached pixmaps: %3 MB."
+		).arg(stats.images
+		).arg(mb(stats.imageBytes)
+		).arg(mb(stats.cacheBytes))));
+	});
 	if (!Core::UpdaterDisabled()) {
 		codes.emplace(qsl("testupdate"), [](SessionController *window) {
 			Core::UpdateChecker().test();
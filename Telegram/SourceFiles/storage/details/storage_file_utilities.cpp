@@ -8,14 +8,19 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/details/storage_file_utilities.h"
 
 #include "mtproto/mtproto_auth_key.h"
+#include "core/startup_trace.h"
 #include "base/platform/base_platform_file_utilities.h"
 #include "base/openssl_help.h"
 #include "base/random.h"
 
 #include <crl/crl_object_on_thread.h>
+#include <crl/crl_async.h>
 #include <QtCore/QtEndian>
 #include <QtCore/QSaveFile>
 
+#include <condition_variable>
+#include <mutex>
+
 namespace Storage {
 namespace details {
 namespace {
@@ -665,6 +670,59 @@ bool ReadEncryptedFile(
 	return ReadEncryptedFile(result, ToFilePart(fkey), basePath, key);
 }
 
+struct FileReadPrefetch::State {
+	std::mutex mutex;
+	std::condition_variable variable;
+	QByteArray data;
+	qint64 position = 0;
+	int32 version = 0;
+	bool success = false;
+	bool finished = false;
+	crl::time duration = 0;
+};
+
+FileReadPrefetch::FileReadPrefetch(
+	const QString &name,
+	const QString &basePath,
+	const MTP::AuthKeyPtr &key)
+: _state(std::make_shared<State>()) {
+	crl::async([=, state = _state] {
+		const auto span = Core::StartupTrace::Span("FileReadPrefetch");
+		const auto started = crl::now();
+		auto read = FileReadDescriptor();
+		const auto success = ReadEncryptedFile(read, name, basePath, key);
+
+		auto lock = std::unique_lock<std::mutex>(state->mutex);
+		if (success) {
+			state->version = read.version;
+			state->position = read.buffer.pos();
+			state->data = read.data;
+		}
+		state->success = success;
+		state->finished = true;
+		state->duration = crl::now() - started;
+		state->variable.notify_one();
+	});
+}
+
+bool FileReadPrefetch::take(FileReadDescriptor &result) {
+	auto lock = std::unique_lock<std::mutex>(_state->mutex);
+	_state->variable.wait(lock, [&] { return _state->finished; });
+	DEBUG_LOG(("App Info: prefetched file read in %1 ms."
+		).arg(_state->duration));
+	if (!_state->success) {
+		return false;
+	}
+	result.version = _state->version;
+	result.data = base::take(_state->data);
+	result.buffer.setBuffer(&result.data);
+	result.buffer.open(QIODevice::ReadOnly);
+	result.buffer.seek(_state->position);
+	result.stream.setDevice(&result.buffer);
+	result.stream.setVersion(QDataStream::Qt_5_1);
+	return true;
+}
+
 void Sync() {
 	Manager.sync();
 }
@@ -106,6 +106,25 @@ bool ReadEncryptedFile(
 	const QString &basePath,
 	const MTP::AuthKeyPtr &key);
 
+// Reads and decrypts a file on a background thread, so that
+// several independent files can be prepared in parallel.
+class FileReadPrefetch final {
+public:
+	FileReadPrefetch(
+		const QString &name,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &key);
+
+	// Waits for the background read to finish.
+	[[nodiscard]] bool take(FileReadDescriptor &result);
+
+private:
+	struct State;
+
+	const std::shared_ptr<State> _state;
+
+};
+
 void Sync();
 void Finish();
 
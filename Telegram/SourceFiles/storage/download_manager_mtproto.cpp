@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtproto_auth_key.h"
 #include "mtproto/mtproto_response.h"
 #include "main/main_session.h"
+#include "core/metrics.h"
 #include "apiwrap.h"
 #include "base/openssl_help.h"
 
@@ -18,8 +19,12 @@ namespace Storage {
 namespace {
 
 constexpr auto kKillSessionTimeout = 15 * crl::time(1000);
+constexpr auto kMinWaitedInSession = 2 * kDownloadPartSize;
 constexpr auto kStartWaitedInSession = 4 * kDownloadPartSize;
-constexpr auto kMaxWaitedInSession = 16 * kDownloadPartSize;
+constexpr auto kMaxWaitedInSession = 32 * kDownloadPartSize;
+constexpr auto kQueuedLowThreshold = 1 * kDownloadPartSize;
+constexpr auto kQueuedHighThreshold = 3 * kDownloadPartSize;
+constexpr auto kRttSmoothing = 8;
 constexpr auto kStartSessionsCount = 1;
 constexpr auto kMaxSessionsCount = 8;
 constexpr auto kMaxTrackedSessionRemoves = 64;
@@ -36,6 +41,19 @@ constexpr auto kBadRequestDurationThreshold = 8 * crl::time(1000);
 // and for successes in all remaining sessions:
 // kRetryAddSessionSuccesses * max(removesCount, kMaxTrackedSessionRemoves)
 
+// The in-flight window of each session is sized like in TCP Vegas:
+// from the minimal and the smoothed request durations we estimate
+// the amount of bytes that wait in queues along the path. While it is
+// below kQueuedLowThreshold the link is underused and the window grows,
+// above kQueuedHighThreshold the window shrinks. New sessions are added
+// only while no session in the dc reports such queueing.
+
+[[nodiscard]] crl::time Smooth(crl::time was, crl::time sample) {
+	return was
+		? ((was * (kRttSmoothing - 1) + sample) / kRttSmoothing)
+		: sample;
+}
+
 } // namespace
 
 void DownloadManagerMtproto::Queue::enqueue(
@@ -143,6 +161,20 @@ void DownloadManagerMtproto::enqueue(not_null<Task*> task, int priority) {
 	checkSendNext(dcId, queue);
 }
 
+void DownloadManagerMtproto::prepareDc(MTP::DcId dcId) {
+	if (!dcId
+		|| dcId == api().instance().mainDcId()
+		|| _balanceData.contains(dcId)
+		|| !_preparedDcs.emplace(dcId).second) {
+		return;
+	}
+	_balanceData.emplace(dcId);
+	api().instance().sendAnything(MTP::downloadDcId(dcId, 0));
+
+	// Keys stay in the dc after the session is stopped.
+	killSessionsSchedule(dcId);
+}
+
 void DownloadManagerMtproto::remove(not_null<Task*> task) {
 	const auto dcId = task->dcId();
 	auto &queue = _queues[dcId];
@@ -257,16 +289,7 @@ void DownloadManagerMtproto::requestSucceeded(
 		});
 		return;
 	}
-	if (amountAtRequestStart == data.maxWaitedAmount
-		&& data.maxWaitedAmount < kMaxWaitedInSession) {
-		data.maxWaitedAmount = std::min(
-			data.maxWaitedAmount + kDownloadPartSize,
-			kMaxWaitedInSession);
-		DEBUG_LOG(("Download (%1,%2) increased max waited amount %3."
-			).arg(dcId
-			).arg(index
-			).arg(data.maxWaitedAmount));
-	}
+	updateWindow(dcId, index, amountAtRequestStart, duration);
 	data.successes = std::min(data.successes + 1, kMaxTrackedSuccesses);
 	const auto notEnough = ranges::any_of(
 		dc.sessions,
@@ -281,7 +304,7 @@ void DownloadManagerMtproto::requestSucceeded(
 	if (dc.timeouts > 0) {
 		--dc.timeouts;
 		return;
-	} else if (dc.sessions.size() == kMaxSessionsCount) {
+	} else if (dc.sessions.size() == kMaxSessionsCount || congested(dc)) {
 		return;
 	}
 	const auto now = crl::now();
@@ -294,6 +317,65 @@ void DownloadManagerMtproto::requestSucceeded(
 		).arg(dcId
 		).arg(dc.sessions.size() - 1
 		).arg(dc.sessions.size()));
+	publishWindow(dcId, dc.sessions.size() - 1);
+}
+
+void DownloadManagerMtproto::updateWindow(
+		MTP::DcId dcId,
+		int index,
+		int amountAtRequestStart,
+		crl::time duration) {
+	auto &data = _balanceData[dcId].sessions[index];
+	const auto rtt = std::max(duration, crl::time(1));
+	data.minRtt = data.minRtt ? std::min(data.minRtt, rtt) : rtt;
+	data.smoothedRtt = Smooth(data.smoothedRtt, rtt);
+	data.goodput = Smooth(
+		data.goodput,
+		int64(amountAtRequestStart) * 1000 / rtt);
+	data.queued = int(int64(amountAtRequestStart)
+		* (data.smoothedRtt - data.minRtt)
+		/ data.smoothedRtt);
+
+	const auto was = data.maxWaitedAmount;
+	if (data.queued > kQueuedHighThreshold) {
+		data.maxWaitedAmount = std::max(
+			was - kDownloadPartSize,
+			kMinWaitedInSession);
+	} else if (data.queued < kQueuedLowThreshold
+		&& amountAtRequestStart == was) {
+		data.maxWaitedAmount = std::min(
+			was + kDownloadPartSize,
+			kMaxWaitedInSession);
+	}
+	if (data.maxWaitedAmount != was) {
+		DEBUG_LOG(("Download (%1,%2) changed max waited amount %3, "
+			"rtt: %4 (min %5), queued: %6, goodput: %7"
+			).arg(dcId
+			).arg(index
+			).arg(data.maxWaitedAmount
+			).arg(data.smoothedRtt
+			).arg(data.minRtt
+			).arg(data.queued
+			).arg(data.goodput));
+		publishWindow(dcId, index);
+	}
+}
+
+bool DownloadManagerMtproto::congested(const DcBalanceData &dc) const {
+	return ranges::any_of(dc.sessions, [](const DcSessionBalanceData &data) {
+		return (data.queued > kQueuedLowThreshold);
+	});
+}
+
+void DownloadManagerMtproto::publishWindow(MTP::DcId dcId, int index) {
+	const auto &dc = _balanceData[dcId];
+	const auto &data = dc.sessions[index];
+	const auto prefix = u"download.dc%1.%2."_q.arg(dcId).arg(index);
+	Core::Metrics::Counter(u"download.dc%1.sessions"_q.arg(dcId))
+		= int64(dc.sessions.size());
+	Core::Metrics::Counter(prefix + "window") = data.maxWaitedAmount;
+	Core::Metrics::Counter(prefix + "min_rtt_ms") = data.minRtt;
+	Core::Metrics::Counter(prefix + "bytes_per_second") = data.goodput;
 }
 
 int DownloadManagerMtproto::chooseSessionIndex(MTP::DcId dcId) const {
@@ -816,6 +898,9 @@ auto DownloadMtprotoTask::finishSentRequest(
 	const auto ok = _requestByOffset.remove(result.offset);
 
 	if (reason == FinishRequestReason::Success) {
+		static auto &Parts = Core::Metrics::Counter("download.parts");
+		++Parts;
+
 		_owner->requestSucceeded(
 			dcId(),
 			result.sessionIndex,
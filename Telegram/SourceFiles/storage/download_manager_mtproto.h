@@ -41,6 +41,10 @@ public:
 	void enqueue(not_null<Task*> task, int priority);
 	void remove(not_null<Task*> task);
 
+	// Connects to the dc in advance, so that the auth key is ready
+	// by the time the first file from it is requested.
+	void prepareDc(MTP::DcId dcId);
+
 	void notifyTaskFinished() {
 		_taskFinished.fire({});
 	}
@@ -81,6 +85,10 @@ private:
 		int requested = 0;
 		int successes = 0; // Since last timeout in this dc in any session.
 		int maxWaitedAmount = 0;
+		crl::time minRtt = 0;
+		crl::time smoothedRtt = 0;
+		int64 goodput = 0; // Bytes per second, smoothed.
+		int queued = 0; // Estimated bytes waiting in the path queues.
 	};
 	struct DcBalanceData {
 		DcBalanceData();
@@ -104,6 +112,14 @@ private:
 
 	void resetGeneration();
 	void sessionTimedOut(MTP::DcId dcId, int index);
+	void updateWindow(
+		MTP::DcId dcId,
+		int index,
+		int amountAtRequestStart,
+		crl::time duration);
+	[[nodiscard]] bool congested(const DcBalanceData &dc) const;
+	// Shown in the "metrics" settings code dump.
+	void publishWindow(MTP::DcId dcId, int index);
 	void removeSession(MTP::DcId dcId);
 
 	const not_null<ApiWrap*> _api;
@@ -114,6 +130,7 @@ private:
 	base::Timer _resetGenerationTimer;
 
 	base::flat_map<MTP::DcId, crl::time> _killSessionsWhen;
+	base::flat_set<MTP::DcId> _preparedDcs;
 	base::Timer _killSessionsTimer;
 
 	base::flat_map<MTP::DcId, Queue> _queues;
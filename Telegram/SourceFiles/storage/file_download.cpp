@@ -193,6 +193,10 @@ void FileLoader::permitLoadFromCloud() {
 	_fromCloud = LoadFromCloudOrLocal;
 }
 
+void FileLoader::setLowPriority(bool lowPriority) {
+	_lowPriority = lowPriority;
+}
+
 void FileLoader::increaseLoadSize(int size, bool autoLoading) {
 	Expects(size > _loadSize);
 	Expects(size <= _fullSize);
@@ -382,7 +386,7 @@ bool FileLoader::writeResultPart(int offset, bytes::const_span buffer) {
 		}
 		return true;
 	}
-	_data.reserve(offset + buffer.size());
+	reserveResultData(offset + buffer.size());
 	if (offset > _data.size()) {
 		_skippedBytes += offset - _data.size();
 		_data.resize(offset);
@@ -402,6 +406,19 @@ bool FileLoader::writeResultPart(int offset, bytes::const_span buffer) {
 	return true;
 }
 
+void FileLoader::reserveResultData(int64 size) {
+	if (size <= _data.capacity()) {
+		return;
+	}
+	// Reserving the exact size for each part would reallocate and copy
+	// the whole loaded buffer every time, so reserve the full file size
+	// when it's known and grow geometrically otherwise.
+	const auto full = int64(_loadSize ? _loadSize : _fullSize);
+	_data.reserve((full >= size)
+		? full
+		: std::max(size, int64(_data.capacity()) * 2));
+}
+
 QByteArray FileLoader::readLoadedPartBack(int offset, int size) {
 	Expects(offset >= 0 && size > 0);
 
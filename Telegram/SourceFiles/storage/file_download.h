@@ -98,6 +98,7 @@ public:
 
 	bool setFileName(const QString &filename); // set filename for loaders to cache
 	void permitLoadFromCloud();
+	void setLowPriority(bool lowPriority);
 	void increaseLoadSize(int size, bool autoLoading);
 
 	void start();
@@ -109,6 +110,9 @@ public:
 	[[nodiscard]] bool autoLoading() const {
 		return _autoLoading;
 	}
+	[[nodiscard]] bool lowPriority() const {
+		return _lowPriority;
+	}
 
 	void localLoaded(
 		const StorageImageSaved &result,
@@ -149,12 +153,14 @@ protected:
 	void notifyAboutProgress();
 
 	bool writeResultPart(int offset, bytes::const_span buffer);
+	void reserveResultData(int64 size);
 	bool finalizeResult();
 	[[nodiscard]] QByteArray readLoadedPartBack(int offset, int size);
 
 	const not_null<Main::Session*> _session;
 
 	bool _autoLoading = false;
+	bool _lowPriority = false;
 	uint8 _cacheTag = 0;
 	bool _finished = false;
 	bool _cancelled = false;
@@ -157,7 +157,8 @@ bool mtpFileLoader::setWebFileSizeHook(int size) {
 }
 
 void mtpFileLoader::startLoading() {
-	addToQueue();
+	// Background auto-downloads go after everything else.
+	addToQueue(lowPriority() ? -1 : 0);
 }
 
 void mtpFileLoader::startLoadingWithPartial(const QByteArray &data) {
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_send_progress.h"
 #include "storage/localimageloader.h"
 #include "storage/file_download.h"
+#include "storage/storage_file_parts_reader.h"
 #include "data/data_document.h"
 #include "data/data_document_media.h"
 #include "data/data_photo.h"
@@ -19,6 +20,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item.h"
 #include "history/history.h"
 #include "core/file_location.h"
+#include "core/metrics.h"
 #include "core/mime_type.h"
 #include "main/main_session.h"
 #include "apiwrap.h"
@@ -26,8 +28,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Storage {
 namespace {
 
-// max 512kb uploaded at the same time in each session
-constexpr auto kMaxUploadFileParallelSize = MTP::kUploadSessionsCount * 512 * 1024;
+// From 512kb to 4mb uploaded at the same time in each session,
+// depending on the measured part acknowledgement latency.
+constexpr auto kMinUploadSessionWindow = uint32(512 * 1024);
+constexpr auto kMaxUploadSessionWindow = uint32(4 * 1024 * 1024);
+constexpr auto kLatencySmoothing = 8;
+
+// Part size is chosen so that one part is sent in about this time.
+constexpr auto kUploadPartTargetDuration = crl::time(250);
 
 constexpr auto kDocumentMaxPartsCount = 4000;
 
@@ -46,7 +54,8 @@ constexpr auto kDocumentUploadPartSize3 = 256 * 1024;
 // 512kb for large document ( <= 1500mb )
 constexpr auto kDocumentUploadPartSize4 = 512 * 1024;
 
-// One part each half second, if not uploaded faster.
+// One part each half second, if not uploaded faster
+// and all the session windows are full.
 constexpr auto kUploadRequestInterval = crl::time(500);
 
 // How much time without upload causes additional session kill.
@@ -56,13 +65,19 @@ constexpr auto kKillSessionTimeout = 15 * crl::time(000);
 	return Core::IsMimeSticker(mime) ? "WEBP" : "JPG";
 }
 
+[[nodiscard]] crl::time SmoothLatency(crl::time was, crl::time sample) {
+	return was
+		? ((was * (kLatencySmoothing - 1) + sample) / kLatencySmoothing)
+		: sample;
+}
+
 } // namespace
 
 struct Uploader::File {
 	File(const SendMediaReady &media);
 	File(const std::shared_ptr<FileLoadResult> &file);
 
-	void setDocSize(int32 size);
+	void setDocSize(int32 size, int32 preferredPartSize = 0);
 	bool setPartSize(uint32 partSize);
 
 	std::shared_ptr<FileLoadResult> file;
@@ -77,11 +92,12 @@ struct Uploader::File {
 
 	HashMd5 md5Hash;
 
-	std::unique_ptr<QFile> docFile;
+	std::unique_ptr<FilePartsReader> docReader;
 	int32 docSentParts = 0;
 	int32 docSize = 0;
 	int32 docPartSize = 0;
 	int32 docPartsCount = 0;
+	bool docPartSizeChosen = false;
 
 };
 
@@ -112,14 +128,17 @@ Uploader::File::File(const std::shared_ptr<FileLoadResult> &file)
 	}
 }
 
-void Uploader::File::setDocSize(int32 size) {
+void Uploader::File::setDocSize(int32 size, int32 preferredPartSize) {
 	docSize = size;
 	constexpr auto limit0 = 1024 * 1024;
 	constexpr auto limit1 = 32 * limit0;
-	if (docSize >= limit0 || !setPartSize(kDocumentUploadPartSize0)) {
-		if (docSize > limit1 || !setPartSize(kDocumentUploadPartSize1)) {
-			if (!setPartSize(kDocumentUploadPartSize2)) {
-				if (!setPartSize(kDocumentUploadPartSize3)) {
+	const auto allowed = [&](int32 partSize) {
+		return (partSize >= preferredPartSize) && setPartSize(partSize);
+	};
+	if (docSize >= limit0 || !allowed(kDocumentUploadPartSize0)) {
+		if (docSize > limit1 || !allowed(kDocumentUploadPartSize1)) {
+			if (!allowed(kDocumentUploadPartSize2)) {
+				if (!allowed(kDocumentUploadPartSize3)) {
 					if (!setPartSize(kDocumentUploadPartSize4)) {
 						LOG(("Upload Error: bad doc size: %1").arg(docSize));
 					}
@@ -208,6 +227,10 @@ Uploader::Uploader(not_null<ApiWrap*> api)
 	) | rpl::start_with_next([=](const FullMsgId &fullId) {
 		processDocumentFailed(fullId);
 	}, _lifetime);
+
+	for (auto &balance : sessionBalance) {
+		balance.window = kMinUploadSessionWindow;
+	}
 }
 
 void Uploader::processPhotoProgress(const FullMsgId &newId) {
@@ -365,6 +388,7 @@ void Uploader::currentFailed() {
 
 	cancelRequests();
 	dcMap.clear();
+	sentTimes.clear();
 	uploadingId = FullMsgId();
 	sentSize = 0;
 	for (int i = 0; i < MTP::kUploadSessionsCount; ++i) {
@@ -399,8 +423,71 @@ void Uploader::stopSessions() {
 	}
 }
 
+int Uploader::chooseSession() const {
+	auto result = -1;
+	auto maxFree = int64(0);
+	for (auto dc = 0; dc != MTP::kUploadSessionsCount; ++dc) {
+		const auto free = int64(sessionBalance[dc].window)
+			- int64(sentSizes[dc]);
+		if (free > maxFree) {
+			maxFree = free;
+			result = dc;
+		}
+	}
+	return result;
+}
+
+int32 Uploader::preferredPartSize() const {
+	auto throughput = int64(); // Bytes per second in all sessions.
+	for (const auto &balance : sessionBalance) {
+		if (balance.smoothedLatency > 0) {
+			throughput += int64(balance.window)
+				* 1000
+				/ balance.smoothedLatency;
+		}
+	}
+	const auto wanted = throughput * kUploadPartTargetDuration / 1000;
+	auto result = kDocumentUploadPartSize0;
+	while (result < kDocumentUploadPartSize4 && result * 2 <= wanted) {
+		result *= 2;
+	}
+	return result;
+}
+
+void Uploader::updateSessionBalance(
+		int dc,
+		uint32 sentPartSize,
+		crl::time sent) {
+	auto &balance = sessionBalance[dc];
+	const auto latency = std::max(crl::now() - sent, crl::time(1));
+	balance.minLatency = balance.minLatency
+		? std::min(balance.minLatency, latency)
+		: latency;
+	balance.smoothedLatency = SmoothLatency(
+		balance.smoothedLatency,
+		latency);
+
+	// While acks come almost as fast as in an idle session we are not
+	// filling any queues yet, so allow more bytes in flight.
+	if (balance.smoothedLatency * 2 <= balance.minLatency * 3) {
+		balance.window = std::min(
+			balance.window + sentPartSize,
+			kMaxUploadSessionWindow);
+	} else if (balance.smoothedLatency > balance.minLatency * 3) {
+		balance.window = std::max(
+			(balance.window > sentPartSize)
+				? (balance.window - sentPartSize)
+				: kMinUploadSessionWindow,
+			kMinUploadSessionWindow);
+	}
+}
+
 void Uploader::sendNext() {
-	if (sentSize >= kMaxUploadFileParallelSize || _pausedId.msg) {
+	if (_pausedId.msg) {
+		return;
+	}
+	const auto todc = chooseSession();
+	if (todc < 0) {
 		return;
 	}
 
@@ -424,13 +511,6 @@ void Uploader::sendNext() {
 	}
 	auto &uploadingData = i->second;
 
-	auto todc = 0;
-	for (auto dc = 1; dc != MTP::kUploadSessionsCount; ++dc) {
-		if (sentSizes[dc] < sentSizes[todc]) {
-			todc = dc;
-		}
-	}
-
 	auto &parts = uploadingData.file
 		? ((uploadingData.type() == SendMediaType::Photo
 			|| uploadingData.type() == SendMediaType::Secure)
@@ -537,19 +617,37 @@ void Uploader::sendNext() {
 		auto &content = uploadingData.file
 			? uploadingData.file->content
 			: uploadingData.media.data;
+		if (!uploadingData.docPartSizeChosen
+			&& (uploadingData.type() == SendMediaType::File
+				|| uploadingData.type() == SendMediaType::ThemeFile
+				|| uploadingData.type() == SendMediaType::Audio)) {
+			// Choose once, before the reader is created with this size.
+			uploadingData.docPartSizeChosen = true;
+			uploadingData.setDocSize(
+				uploadingData.docSize,
+				preferredPartSize());
+		}
 		QByteArray toSend;
 		if (content.isEmpty()) {
-			if (!uploadingData.docFile) {
+			if (!uploadingData.docReader) {
 				const auto filepath = uploadingData.file
 					? uploadingData.file->filepath
 					: uploadingData.media.file;
-				uploadingData.docFile = std::make_unique<QFile>(filepath);
-				if (!uploadingData.docFile->open(QIODevice::ReadOnly)) {
-					currentFailed();
-					return;
-				}
+				uploadingData.docReader = std::make_unique<FilePartsReader>(
+					filepath,
+					uploadingData.docPartSize,
+					[=] { sendNext(); });
 			}
-			toSend = uploadingData.docFile->read(uploadingData.docPartSize);
+			if (uploadingData.docReader->failed()) {
+				currentFailed();
+				return;
+			}
+			auto part = uploadingData.docReader->takeNextPart();
+			if (!part) {
+				// sendNext() will be called when the part is read.
+				return;
+			}
+			toSend = std::move(*part);
 			if (uploadingData.docSize <= kUseBigFilesFrom) {
 				uploadingData.md5Hash.feed(toSend.constData(), toSend.size());
 			}
@@ -560,7 +658,7 @@ void Uploader::sendNext() {
 			if ((uploadingData.type() == SendMediaType::File
 				|| uploadingData.type() == SendMediaType::ThemeFile
 				|| uploadingData.type() == SendMediaType::Audio)
-				&& uploadingData.docSentParts <= kUseBigFilesFrom) {
+				&& uploadingData.docSize <= kUseBigFilesFrom) {
 				uploadingData.md5Hash.feed(toSend.constData(), toSend.size());
 			}
 		}
@@ -595,6 +693,7 @@ void Uploader::sendNext() {
 		}
 		docRequestsSent.emplace(requestId, uploadingData.docSentParts);
 		dcMap.emplace(requestId, todc);
+		sentTimes.emplace(requestId, crl::now());
 		sentSize += uploadingData.docPartSize;
 		sentSizes[todc] += uploadingData.docPartSize;
 
@@ -613,12 +712,15 @@ void Uploader::sendNext() {
 		}).toDC(MTP::uploadDcId(todc)).send();
 		requestsSent.emplace(requestId, part.value());
 		dcMap.emplace(requestId, todc);
+		sentTimes.emplace(requestId, crl::now());
 		sentSize += part.value().size();
 		sentSizes[todc] += part.value().size();
 
 		parts.erase(part);
 	}
-	_nextTimer.callOnce(kUploadRequestInterval);
+	_nextTimer.callOnce((chooseSession() >= 0)
+		? crl::time(0)
+		: kUploadRequestInterval);
 }
 
 void Uploader::cancel(const FullMsgId &msgId) {
@@ -674,6 +776,7 @@ void Uploader::clear() {
 	queue.clear();
 	cancelRequests();
 	dcMap.clear();
+	sentTimes.clear();
 	sentSize = 0;
 	for (int i = 0; i < MTP::kUploadSessionsCount; ++i) {
 		_api->instance().stopSession(MTP::uploadDcId(i));
@@ -714,6 +817,13 @@ void Uploader::partLoaded(const MTPBool &result, mtpRequestId requestId) {
 			}
 			sentSize -= sentPartSize;
 			sentSizes[dc] -= sentPartSize;
+
+			static auto &Uploaded = Core::Metrics::Counter("upload.bytes");
+			Uploaded += sentPartSize;
+
+			if (const auto sent = sentTimes.take(requestId)) {
+				updateSessionBalance(dc, sentPartSize, *sent);
+			}
 			if (file.type() == SendMediaType::Photo) {
 				file.fileSentSize += sentPartSize;
 				const auto photo = session().data().photo(file.id());
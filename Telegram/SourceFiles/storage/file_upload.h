@@ -104,6 +104,11 @@ public:
 
 private:
 	struct File;
+	struct SessionBalance {
+		uint32 window = 0;
+		crl::time minLatency = 0;
+		crl::time smoothedLatency = 0;
+	};
 
 	void partLoaded(const MTPBool &result, mtpRequestId requestId);
 	void partFailed(const MTP::Error &error, mtpRequestId requestId);
@@ -113,6 +118,10 @@ private:
 	void processDocumentProgress(const FullMsgId &msgId);
 	void processDocumentFailed(const FullMsgId &msgId);
 
+	[[nodiscard]] int chooseSession() const;
+	[[nodiscard]] int32 preferredPartSize() const;
+	void updateSessionBalance(int dc, uint32 sentPartSize, crl::time sent);
+
 	void notifyFailed(FullMsgId id, const File &file);
 	void currentFailed();
 	void cancelRequests();
@@ -126,8 +135,10 @@ private:
 	base::flat_map<mtpRequestId, QByteArray> requestsSent;
 	base::flat_map<mtpRequestId, int32> docRequestsSent;
 	base::flat_map<mtpRequestId, int32> dcMap;
+	base::flat_map<mtpRequestId, crl::time> sentTimes;
 	uint32 sentSize = 0;
 	uint32 sentSizes[MTP::kUploadSessionsCount] = { 0 };
+	SessionBalance sessionBalance[MTP::kUploadSessionsCount];
 
 	FullMsgId uploadingId;
 	FullMsgId _pausedId;
@@ -44,6 +44,7 @@ constexpr auto kThumbnailQuality = 87;
 constexpr auto kThumbnailSize = 320;
 constexpr auto kPhotoUploadPartSize = 32 * 1024;
 constexpr auto kRecompressAfterBpp = 4;
+constexpr auto kMaxTaskQueueThreads = 8;
 
 using Ui::ValidateThumbDimensions;
 
@@ -283,7 +284,10 @@ SendMediaReady::SendMediaReady(
 	}
 }
 
-TaskQueue::TaskQueue(crl::time stopTimeoutMs) {
+TaskQueue::TaskQueue(crl::time stopTimeoutMs, int threadsCount)
+: _threadsCount((threadsCount > 0)
+	? threadsCount
+	: std::clamp(QThread::idealThreadCount(), 1, kMaxTaskQueueThreads)) {
 	if (stopTimeoutMs > 0) {
 		_stopTimer = new QTimer(this);
 		connect(_stopTimer, SIGNAL(timeout()), this, SLOT(stop()));
@@ -296,6 +300,8 @@ TaskId TaskQueue::addTask(std::unique_ptr<Task> &&task) {
 	const auto result = task->id();
 	{
 		QMutexLocker lock(&_tasksToProcessMutex);
+		QMutexLocker lockToFinish(&_tasksToFinishMutex);
+		_tasksFinishOrder.push_back(result);
 		_tasksToProcess.push_back(std::move(task));
 	}
 
@@ -307,7 +313,9 @@ TaskId TaskQueue::addTask(std::unique_ptr<Task> &&task) {
 void TaskQueue::addTasks(std::vector<std::unique_ptr<Task>> &&tasks) {
 	{
 		QMutexLocker lock(&_tasksToProcessMutex);
+		QMutexLocker lockToFinish(&_tasksToFinishMutex);
 		for (auto &task : tasks) {
+			_tasksFinishOrder.push_back(task->id());
 			_tasksToProcess.push_back(std::move(task));
 		}
 	}
@@ -316,16 +324,24 @@ void TaskQueue::addTasks(std::vector<std::unique_ptr<Task>> &&tasks) {
 }
 
 void TaskQueue::wakeThread() {
-	if (!_thread) {
-		_thread = new QThread();
+	auto wanted = 0;
+	{
+		QMutexLocker lock(&_tasksToProcessMutex);
+		wanted = std::min(
+			int(_tasksToProcess.size() + _tasksInProcessIds.size()),
+			_threadsCount);
+	}
+	while (int(_workers.size()) < std::max(wanted, 1)) {
+		auto &added = _workers.emplace_back();
+		added.thread = new QThread();
 
-		_worker = new TaskQueueWorker(this);
-		_worker->moveToThread(_thread);
+		added.worker = new TaskQueueWorker(this);
+		added.worker->moveToThread(added.thread);
 
-		connect(this, SIGNAL(taskAdded()), _worker, SLOT(onTaskAdded()));
-		connect(_worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
+		connect(this, SIGNAL(taskAdded()), added.worker, SLOT(onTaskAdded()));
+		connect(added.worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
 
-		_thread->start();
+		added.thread->start();
 	}
 	if (_stopTimer) _stopTimer->stop();
 	taskAdded();
@@ -344,46 +360,70 @@ void TaskQueue::cancelTask(TaskId id) {
 	{
 		QMutexLocker lock(&_tasksToProcessMutex);
 		removeFrom(_tasksToProcess);
-		if (_taskInProcessId == id) {
-			_taskInProcessId = TaskId();
-		}
+		_tasksInProcessIds.erase(
+			ranges::remove(_tasksInProcessIds, id),
+			end(_tasksInProcessIds));
 	}
 	QMutexLocker lock(&_tasksToFinishMutex);
 	removeFrom(_tasksToFinish);
+	_tasksFinishOrder.erase(
+		ranges::remove(_tasksFinishOrder, id),
+		end(_tasksFinishOrder));
+}
+
+std::unique_ptr<Task> TaskQueue::takeNextReadyToFinish() {
+	QMutexLocker lock(&_tasksToFinishMutex);
+	if (_tasksFinishOrder.empty()) {
+		return nullptr;
+	}
+
+	// Tasks are processed in parallel, but finished in the order added.
+	const auto proj = [](const std::unique_ptr<Task> &task) {
+		return task->id();
+	};
+	const auto i = ranges::find(
+		_tasksToFinish,
+		_tasksFinishOrder.front(),
+		proj);
+	if (i == end(_tasksToFinish)) {
+		return nullptr;
+	}
+	auto result = std::move(*i);
+	_tasksToFinish.erase(i);
+	_tasksFinishOrder.pop_front();
+	return result;
 }
 
 void TaskQueue::onTaskProcessed() {
-	do {
-		auto task = std::unique_ptr<Task>();
-		{
-			QMutexLocker lock(&_tasksToFinishMutex);
-			if (_tasksToFinish.empty()) break;
-			task = std::move(_tasksToFinish.front());
-			_tasksToFinish.pop_front();
-		}
+	while (const auto task = takeNextReadyToFinish()) {
 		task->finish();
-	} while (true);
+	}
 
 	if (_stopTimer) {
 		QMutexLocker lock(&_tasksToProcessMutex);
-		if (_tasksToProcess.empty() && !_taskInProcessId) {
+		if (_tasksToProcess.empty() && _tasksInProcessIds.empty()) {
 			_stopTimer->start();
 		}
 	}
 }
 
 void TaskQueue::stop() {
-	if (_thread) {
-		_thread->requestInterruption();
-		_thread->quit();
+	for (const auto &worker : _workers) {
+		worker.thread->requestInterruption();
+		worker.thread->quit();
+	}
+	if (!_workers.empty()) {
 		DEBUG_LOG(("Waiting for taskThread to finish"));
-		_thread->wait();
-		delete base::take(_worker);
-		delete base::take(_thread);
+	}
+	for (auto &worker : base::take(_workers)) {
+		worker.thread->wait();
+		delete worker.worker;
+		delete worker.thread;
 	}
 	_tasksToProcess.clear();
 	_tasksToFinish.clear();
-	_taskInProcessId = TaskId();
+	_tasksFinishOrder.clear();
+	_tasksInProcessIds.clear();
 }
 
 TaskQueue::~TaskQueue() {
@@ -403,21 +443,24 @@ void TaskQueueWorker::onTaskAdded() {
 			if (!_queue->_tasksToProcess.empty()) {
 				task = std::move(_queue->_tasksToProcess.front());
 				_queue->_tasksToProcess.pop_front();
-				_queue->_taskInProcessId = task->id();
+				_queue->_tasksInProcessIds.push_back(task->id());
 			}
 		}
 
+		someTasksLeft = false;
 		if (task) {
 			task->process();
 			bool emitTaskProcessed = false;
 			{
 				QMutexLocker lockToProcess(&_queue->_tasksToProcessMutex);
-				if (_queue->_taskInProcessId == task->id()) {
-					_queue->_taskInProcessId = TaskId();
-					someTasksLeft = !_queue->_tasksToProcess.empty();
+				auto &ids = _queue->_tasksInProcessIds;
+				const auto i = ranges::find(ids, task->id());
+				someTasksLeft = !_queue->_tasksToProcess.empty();
+				if (i != end(ids)) {
+					ids.erase(i);
 
 					QMutexLocker lockToFinish(&_queue->_tasksToFinishMutex);
-					emitTaskProcessed = _queue->_tasksToFinish.empty();
+					emitTaskProcessed = true;
 					_queue->_tasksToFinish.push_back(std::move(task));
 				}
 			}
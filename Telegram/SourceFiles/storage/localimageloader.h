@@ -117,7 +117,9 @@ class TaskQueue : public QObject {
 	Q_OBJECT
 
 public:
-	explicit TaskQueue(crl::time stopTimeoutMs = 0); // <= 0 - never stop worker
+	// stopTimeoutMs <= 0 - never stop workers.
+	// threadsCount <= 0 - use one worker thread for each core.
+	explicit TaskQueue(crl::time stopTimeoutMs = 0, int threadsCount = 1);
 
 	TaskId addTask(std::unique_ptr<Task> &&task);
 	void addTasks(std::vector<std::unique_ptr<Task>> &&tasks);
@@ -135,14 +137,21 @@ public Q_SLOTS:
 private:
 	friend class TaskQueueWorker;
 
+	struct Worker {
+		QThread *thread = nullptr;
+		TaskQueueWorker *worker = nullptr;
+	};
+
 	void wakeThread();
+	[[nodiscard]] std::unique_ptr<Task> takeNextReadyToFinish();
 
+	const int _threadsCount = 1;
 	std::deque<std::unique_ptr<Task>> _tasksToProcess;
 	std::deque<std::unique_ptr<Task>> _tasksToFinish;
-	TaskId _taskInProcessId = TaskId();
+	std::deque<TaskId> _tasksFinishOrder;
+	std::vector<TaskId> _tasksInProcessIds;
 	QMutex _tasksToProcessMutex, _tasksToFinishMutex;
-	QThread *_thread = nullptr;
-	TaskQueueWorker *_worker = nullptr;
+	std::vector<Worker> _workers;
 	QTimer *_stopTimer = nullptr;
 
 };
@@ -25,6 +25,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "core/application.h"
 #include "core/file_location.h"
+#include "core/startup_trace.h"
 #include "data/stickers/data_stickers.h"
 #include "data/data_session.h"
 #include "data/data_document.h"
@@ -33,6 +34,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "export/export_settings.h"
 #include "window/themes/window_theme.h"
 
+#include <QtCore/QSaveFile>
+
 namespace Storage {
 namespace {
 
@@ -41,8 +44,20 @@ using Database = Cache::Database;
 
 constexpr auto kDelayedWriteTimeout = crl::time(1000);
 
+// Draft keys changes are appended to a small journal instead of rewriting
+// the whole map. After that many changes the map is rewritten (compacted).
+constexpr auto kMaxMapJournalEntries = 128;
+
+// Journal entries are kept for a couple of map generations in case the
+// latest map rewrite didn't reach the disk when the journal did.
+constexpr auto kMapJournalKeepGenerations = quint64(2);
+
+// Each journal record is encrypted separately and appended to this file.
+constexpr auto kMapJournalName = "mapjournal"_cs;
+
 constexpr auto kStickersVersionTag = quint32(-1);
-constexpr auto kStickersSerializeVersion = 2;
+constexpr auto kStickersSerializeVersion = 3;
+constexpr auto kStickersSerializeVersionInline = 2;
 constexpr auto kMaxSavedStickerSetsCount = 1000;
 constexpr auto kDefaultStickerInstallDate = TimeId(1);
 
@@ -83,6 +98,7 @@ enum { // Local Storage Keys
 	lskBackgroundOld = 0x14, // no data
 	lskSelfSerialized = 0x15, // serialized self
 	lskMasksKeys = 0x16, // no data
+	lskMapGeneration = 0x17, // no data
 };
 
 auto EmptyMessageDraftSources()
@@ -119,6 +135,15 @@ auto EmptyMessageDraftSources()
 	return cWorkingDir() + qsl("tdata/tdld/");
 }
 
+// Lazily read sets keep their stickers serialized until the first access.
+[[nodiscard]] bool KeepLocalStickers(const Data::StickersSet &set) {
+	return set.stickers.isEmpty() && !set.localStickers.isEmpty();
+}
+
+[[nodiscard]] bool NoStickersToWrite(const Data::StickersSet &set) {
+	return set.stickers.isEmpty() && set.localStickers.isEmpty();
+}
+
 } // namespace
 
 Account::Account(not_null<Main::Account*> owner, const QString &dataName)
@@ -137,6 +162,9 @@ Account::Account(not_null<Main::Account*> owner, const QString &dataName)
 }
 
 Account::~Account() {
+	if (_localKey && _locationsChanged) {
+		writeLocations();
+	}
 	if (_localKey && _mapChanged) {
 		writeMap();
 	}
@@ -161,9 +189,37 @@ std::unique_ptr<MTP::Config> Account::start(MTP::AuthKeyPtr localKey) {
 	Expects(localKey != nullptr);
 
 	_localKey = std::move(localKey);
-	readMapWith(_localKey);
+	prefetchStartFiles();
+	{
+		const auto span = Core::StartupTrace::Span("Storage::readMap");
+		readMapWith(_localKey);
+	}
 	clearLegacyFiles();
-	return readMtpConfig();
+
+	const auto ms = crl::now();
+	const auto span = Core::StartupTrace::Span("Storage::readMtpConfig");
+	auto result = readMtpConfig();
+	LOG(("MTP config read time: %1").arg(crl::now() - ms));
+	return result;
+}
+
+void Account::prefetchStartFiles() {
+	Expects(_localKey != nullptr);
+
+	// Those files don't depend on the map contents, so we decrypt them
+	// in the background while the map is being read on the main thread.
+	if (!_mtpDataPrefetch) {
+		_mtpDataPrefetch = std::make_unique<FileReadPrefetch>(
+			ToFilePart(_dataNameKey),
+			BaseGlobalPath(),
+			_localKey);
+	}
+	if (!_mtpConfigPrefetch) {
+		_mtpConfigPrefetch = std::make_unique<FileReadPrefetch>(
+			u"config"_q,
+			_basePath,
+			_localKey);
+	}
 }
 
 void Account::startAdded(MTP::AuthKeyPtr localKey) {
@@ -207,6 +263,7 @@ base::flat_set<QString> Account::collectGoodNames() const {
 		"map0",
 		"map1",
 		"maps",
+		kMapJournalName.utf16(),
 		"configs",
 	};
 	const auto push = [&](FileKey key) {
@@ -237,6 +294,12 @@ Account::ReadMapResult Account::readMapWith(
 		const QByteArray &legacyPasscode) {
 	auto ms = crl::now();
 
+	// The mtp data prefetch is consumed by readMtpData() on success,
+	// drop it on the early returns so it doesn't outlive the start.
+	const auto prefetchGuard = gsl::finally([&] {
+		_mtpDataPrefetch = nullptr;
+	});
+
 	FileReadDescriptor mapData;
 	if (!ReadFile(mapData, qsl("map"), _basePath)) {
 		return ReadMapResult::Failed;
@@ -286,6 +349,7 @@ Account::ReadMapResult Account::readMapWith(
 	quint64 savedGifsKey = 0;
 	quint64 legacyBackgroundKeyDay = 0, legacyBackgroundKeyNight = 0;
 	quint64 userSettingsKey = 0, recentHashtagsAndBotsKey = 0, exportSettingsKey = 0;
+	quint64 mapGeneration = 0;
 	while (!map.stream.atEnd()) {
 		quint32 keyType;
 		map.stream >> keyType;
@@ -385,6 +449,9 @@ Account::ReadMapResult Account::readMapWith(
 				>> recentMasksKey
 				>> archivedMasksKey;
 		} break;
+		case lskMapGeneration: {
+			map.stream >> mapGeneration;
+		} break;
 		default:
 			LOG(("App Error: unknown key type in encrypted map: %1").arg(keyType));
 			return ReadMapResult::Failed;
@@ -394,6 +461,19 @@ Account::ReadMapResult Account::readMapWith(
 		}
 	}
 
+	// Start decrypting the settings while we read the map journal.
+	_settingsPrefetch = std::make_unique<FileReadPrefetch>(
+		ToFilePart(userSettingsKey),
+		_basePath,
+		localKey);
+
+	readMapJournal(
+		localKey,
+		mapGeneration,
+		draftsMap,
+		draftCursorsMap,
+		draftsNotReadMap);
+
 	_localKey = std::move(localKey);
 
 	_draftsMap = draftsMap;
@@ -425,9 +505,9 @@ Account::ReadMapResult Account::readMapWith(
 		_mapChanged = false;
 	}
 
-	if (_locationsKey) {
-		readLocations();
-	}
+	// File locations are read lazily on the first use.
+	_locationsRead = false;
+
 	if (_legacyBackgroundKeyDay || _legacyBackgroundKeyNight) {
 		Local::moveLegacyBackground(
 			_basePath,
@@ -436,8 +516,15 @@ Account::ReadMapResult Account::readMapWith(
 			_legacyBackgroundKeyNight);
 	}
 
+	LOG(("Map parse time: %1").arg(crl::now() - ms));
+
+	const auto settingsStarted = crl::now();
 	auto stored = readSessionSettings();
+	const auto mtpDataStarted = crl::now();
 	readMtpData();
+	LOG(("Session settings read time: %1, MTP data read time: %2"
+		).arg(mtpDataStarted - settingsStarted
+		).arg(crl::now() - mtpDataStarted));
 
 	DEBUG_LOG(("selfSerialized set: %1").arg(selfSerialized.size()));
 	_owner->setSessionFromStorage(
@@ -450,6 +537,158 @@ Account::ReadMapResult Account::readMapWith(
 	return ReadMapResult::Success;
 }
 
+void Account::readMapJournal(
+		const MTP::AuthKeyPtr &localKey,
+		quint64 mapGeneration,
+		base::flat_map<PeerId, FileKey> &draftsMap,
+		base::flat_map<PeerId, FileKey> &draftCursorsMap,
+		base::flat_map<PeerId, bool> &draftsNotReadMap) {
+	_mapGeneration = mapGeneration;
+	_mapJournal.clear();
+
+	const auto path = _basePath + kMapJournalName.utf16();
+	QFile journal(path);
+	if (!journal.open(QIODevice::ReadOnly)) {
+		return;
+	}
+	auto entries = std::vector<MapJournalEntry>();
+	auto stream = QDataStream(&journal);
+	stream.setVersion(QDataStream::Qt_5_1);
+	auto valid = qint64(0);
+	while (!stream.atEnd()) {
+		auto encrypted = QByteArray();
+		stream >> encrypted;
+
+		EncryptedDescriptor record;
+		if (stream.status() != QDataStream::Ok
+			|| !DecryptLocal(record, encrypted, localKey)) {
+			break;
+		}
+		quint64 generation = 0, peerIdSerialized = 0, key = 0;
+		quint32 keyType = 0;
+		record.stream >> generation >> keyType >> peerIdSerialized >> key;
+		if (!CheckStreamStatus(record.stream)) {
+			break;
+		}
+		entries.push_back({
+			.generation = generation,
+			.keyType = keyType,
+			.peerId = DeserializePeerId(peerIdSerialized),
+			.key = key,
+		});
+		valid = journal.pos();
+	}
+	const auto size = journal.size();
+	journal.close();
+	if (valid < size) {
+		// The last append was cut off, drop it so that next ones are read.
+		LOG(("App Warning: map journal truncated from %1 to %2."
+			).arg(size
+			).arg(valid));
+		QFile::resize(path, valid);
+	}
+	for (const auto &entry : entries) {
+		if (entry.generation < mapGeneration) {
+			// This change is already in the map.
+			continue;
+		}
+		auto &map = (entry.keyType == lskDraft)
+			? draftsMap
+			: draftCursorsMap;
+		if (entry.keyType != lskDraft && entry.keyType != lskDraftPosition) {
+			LOG(("App Error: unknown key type in map journal: %1"
+				).arg(entry.keyType));
+			continue;
+		} else if (entry.key) {
+			map[entry.peerId] = entry.key;
+			if (entry.keyType == lskDraft) {
+				draftsNotReadMap[entry.peerId] = true;
+			}
+		} else {
+			map.remove(entry.peerId);
+			if (entry.keyType == lskDraft) {
+				draftsNotReadMap.remove(entry.peerId);
+			}
+		}
+		_mapGeneration = std::max(_mapGeneration, entry.generation);
+		_mapJournal.push_back(entry);
+	}
+	LOG(("App Info: map journal entries applied: %1").arg(_mapJournal.size()));
+}
+
+void Account::journalMapChange(
+		quint32 keyType,
+		PeerId peerId,
+		FileKey key) {
+	_mapJournal.push_back({
+		.generation = _mapGeneration,
+		.keyType = keyType,
+		.peerId = peerId,
+		.key = key,
+	});
+	const auto current = ranges::count(
+		_mapJournal,
+		_mapGeneration,
+		&MapJournalEntry::generation);
+	if (current >= kMaxMapJournalEntries) {
+		writeMapDelayed();
+	}
+	appendMapJournal(_mapJournal.back());
+}
+
+QByteArray Account::serializeMapJournalEntry(
+		const MapJournalEntry &entry) const {
+	Expects(_localKey != nullptr);
+
+	EncryptedDescriptor data(sizeof(quint64) * 3 + sizeof(quint32));
+	data.stream
+		<< quint64(entry.generation)
+		<< quint32(entry.keyType)
+		<< SerializePeerId(entry.peerId)
+		<< quint64(entry.key);
+
+	auto result = QByteArray();
+	auto stream = QDataStream(&result, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_1);
+	stream << PrepareEncrypted(data, _localKey);
+	return result;
+}
+
+void Account::appendMapJournal(const MapJournalEntry &entry) {
+	if (!QDir().exists(_basePath)) {
+		QDir().mkpath(_basePath);
+	}
+	QFile journal(_basePath + kMapJournalName.utf16());
+	if (!journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		LOG(("App Error: could not open map journal for appending."));
+		writeMapDelayed();
+		return;
+	}
+	const auto record = serializeMapJournalEntry(entry);
+	if (journal.write(record) != record.size()) {
+		LOG(("App Error: could not append to map journal."));
+		writeMapDelayed();
+	}
+}
+
+void Account::writeMapJournal() {
+	const auto path = _basePath + kMapJournalName.utf16();
+	if (_mapJournal.empty()) {
+		QFile::remove(path);
+		return;
+	}
+	auto records = QByteArray();
+	for (const auto &entry : _mapJournal) {
+		records.append(serializeMapJournalEntry(entry));
+	}
+	QSaveFile journal(path);
+	if (!journal.open(QIODevice::WriteOnly)
+		|| journal.write(records) != records.size()
+		|| !journal.commit()) {
+		LOG(("App Error: could not rewrite map journal."));
+	}
+}
+
 void Account::writeMapDelayed() {
 	_mapChanged = true;
 	_writeMapTimer.callOnce(kDelayedWriteTimeout);
@@ -519,6 +758,7 @@ void Account::writeMap() {
 	if (_installedMasksKey || _recentMasksKey || _archivedMasksKey) {
 		mapSize += sizeof(quint32) + 3 * sizeof(quint64);
 	}
+	mapSize += sizeof(quint32) + sizeof(quint64);
 
 	EncryptedDescriptor mapData(mapSize);
 	if (!self.isEmpty()) {
@@ -571,15 +811,33 @@ void Account::writeMap() {
 			<< quint64(_recentMasksKey)
 			<< quint64(_archivedMasksKey);
 	}
+
+	// All the journaled changes are written to the map with this generation.
+	++_mapGeneration;
+	mapData.stream << quint32(lskMapGeneration) << quint64(_mapGeneration);
 	map.writeEncrypted(mapData, _localKey);
 
 	_mapChanged = false;
+
+	const auto keepFrom = (_mapGeneration > kMapJournalKeepGenerations)
+		? (_mapGeneration - kMapJournalKeepGenerations)
+		: quint64(0);
+	const auto obsolete = [&](const MapJournalEntry &entry) {
+		return (entry.generation < keepFrom);
+	};
+	const auto from = ranges::remove_if(_mapJournal, obsolete);
+	if (from != end(_mapJournal)) {
+		_mapJournal.erase(from, end(_mapJournal));
+		writeMapJournal();
+	}
 }
 
 void Account::reset() {
 	auto names = collectGoodNames();
 	_draftsMap.clear();
 	_draftCursorsMap.clear();
+	_draftsWritten.clear();
+	_draftCursorsWritten.clear();
 	_draftsNotReadMap.clear();
 	_locationsKey = _trustedBotsKey = 0;
 	_recentStickersKeyOld = 0;
@@ -595,9 +853,11 @@ void Account::reset() {
 	_legacyBackgroundKeyDay = _legacyBackgroundKeyNight = 0;
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
 	_oldMapVersion = 0;
+	_mapJournal.clear();
 	_fileLocations.clear();
 	_fileLocationPairs.clear();
 	_fileLocationAliases.clear();
+	_locationsRead = true;
 	_downloadsSerialize = nullptr;
 	_downloadsSerialized = QByteArray();
 	_cacheTotalSizeLimit = Database::Settings().totalSizeLimit;
@@ -606,13 +866,17 @@ void Account::reset() {
 	_cacheBigFileTotalTimeLimit = Database::Settings().totalTimeLimit;
 	_mapChanged = true;
 	writeMap();
+	writeMapJournal();
 	writeMtpData();
 
+	// The journal was already cleared above and new changes may be
+	// appended to it before the cleanup below runs, so keep it.
 	crl::async([base = _basePath, temp = _tempPath, names = std::move(names)] {
 		for (const auto &name : names) {
 			if (!name.endsWith(qstr("map0"))
 				&& !name.endsWith(qstr("map1"))
 				&& !name.endsWith(qstr("maps"))
+				&& name != kMapJournalName.utf16()
 				&& !name.endsWith(qstr("configs"))) {
 				QFile::remove(base + name);
 			}
@@ -630,6 +894,7 @@ void Account::writeLocations() {
 		return;
 	}
 	_locationsChanged = false;
+	ensureLocationsRead();
 
 	if (_downloadsSerialize) {
 		if (auto serialized = _downloadsSerialize()) {
@@ -703,18 +968,21 @@ void Account::writeLocations() {
 	}
 }
 
-void Account::writeLocationsQueued() {
-	_locationsChanged = true;
-	crl::on_main(_owner, [=] {
-		writeLocations();
-	});
-}
-
 void Account::writeLocationsDelayed() {
 	_locationsChanged = true;
 	_writeLocationsTimer.callOnce(kDelayedWriteTimeout);
 }
 
+void Account::ensureLocationsRead() {
+	if (_locationsRead) {
+		return;
+	}
+	_locationsRead = true;
+	if (_locationsKey) {
+		readLocations();
+	}
+}
+
 void Account::readLocations() {
 	FileReadDescriptor locations;
 	if (!ReadEncryptedFile(locations, _locationsKey, _basePath, _localKey)) {
@@ -783,7 +1051,8 @@ void Account::updateDownloads(
 	writeLocationsDelayed();
 }
 
-QByteArray Account::downloadsSerialized() const {
+QByteArray Account::downloadsSerialized() {
+	ensureLocationsRead();
 	return _downloadsSerialized;
 }
 
@@ -850,7 +1119,10 @@ ReadSettingsContext Account::prepareReadSettingsContext() const {
 std::unique_ptr<Main::SessionSettings> Account::readSessionSettings() {
 	ReadSettingsContext context;
 	FileReadDescriptor userSettings;
-	if (!ReadEncryptedFile(userSettings, _settingsKey, _basePath, _localKey)) {
+	const auto read = _settingsPrefetch
+		? base::take(_settingsPrefetch)->take(userSettings)
+		: ReadEncryptedFile(userSettings, _settingsKey, _basePath, _localKey);
+	if (!read) {
 		LOG(("App Info: could not read encrypted user settings..."));
 
 		Local::readOldUserSettings(true, context);
@@ -939,7 +1211,14 @@ void Account::readMtpData() {
 	auto context = prepareReadSettingsContext();
 
 	FileReadDescriptor mtp;
-	if (!ReadEncryptedFile(mtp, ToFilePart(_dataNameKey), BaseGlobalPath(), _localKey)) {
+	const auto read = _mtpDataPrefetch
+		? base::take(_mtpDataPrefetch)->take(mtp)
+		: ReadEncryptedFile(
+			mtp,
+			ToFilePart(_dataNameKey),
+			BaseGlobalPath(),
+			_localKey);
+	if (!read) {
 		if (_localKey) {
 			Local::readOldMtpData(true, context);
 			applyReadContext(std::move(context));
@@ -979,7 +1258,10 @@ std::unique_ptr<MTP::Config> Account::readMtpConfig() {
 	Expects(_localKey != nullptr);
 
 	FileReadDescriptor file;
-	if (!ReadEncryptedFile(file, "config", _basePath, _localKey)) {
+	const auto read = _mtpConfigPrefetch
+		? base::take(_mtpConfigPrefetch)->take(file)
+		: ReadEncryptedFile(file, "config", _basePath, _localKey);
+	if (!read) {
 		return nullptr;
 	}
 
@@ -1076,8 +1358,9 @@ void Account::writeDrafts(not_null<History*> history) {
 		if (i != _draftsMap.cend()) {
 			ClearKey(i->second, _basePath);
 			_draftsMap.erase(i);
-			writeMapDelayed();
+			journalMapChange(lskDraft, peerId, 0);
 		}
+		_draftsWritten.remove(peerId);
 
 		_draftsNotReadMap.remove(peerId);
 		return;
@@ -1086,7 +1369,8 @@ void Account::writeDrafts(not_null<History*> history) {
 	auto i = _draftsMap.find(peerId);
 	if (i == _draftsMap.cend()) {
 		i = _draftsMap.emplace(peerId, GenerateKey(_basePath)).first;
-		writeMapQueued();
+		journalMapChange(lskDraft, peerId, i->second);
+		_draftsWritten.remove(peerId);
 	}
 
 	auto size = int(sizeof(quint64) * 2 + sizeof(quint32));
@@ -1134,8 +1418,13 @@ void Account::writeDrafts(not_null<History*> history) {
 		sources,
 		writeCallback);
 
-	FileWriteDescriptor file(i->second, _basePath);
-	file.writeEncrypted(data, _localKey);
+	// Saving is triggered by timers while typing, skip the same content.
+	auto &written = _draftsWritten[peerId];
+	if (written != data.data) {
+		written = data.data;
+		FileWriteDescriptor file(i->second, _basePath);
+		file.writeEncrypted(data, _localKey);
+	}
 
 	_draftsNotReadMap.remove(peerId);
 }
@@ -1166,7 +1455,8 @@ void Account::writeDraftCursors(not_null<History*> history) {
 	auto i = _draftCursorsMap.find(peerId);
 	if (i == _draftCursorsMap.cend()) {
 		i = _draftCursorsMap.emplace(peerId, GenerateKey(_basePath)).first;
-		writeMapQueued();
+		journalMapChange(lskDraftPosition, peerId, i->second);
+		_draftCursorsWritten.remove(peerId);
 	}
 
 	auto size = int(sizeof(quint64) * 2
@@ -1198,8 +1488,12 @@ void Account::writeDraftCursors(not_null<History*> history) {
 		sources,
 		writeCallback);
 
-	FileWriteDescriptor file(i->second, _basePath);
-	file.writeEncrypted(data, _localKey);
+	auto &written = _draftCursorsWritten[peerId];
+	if (written != data.data) {
+		written = data.data;
+		FileWriteDescriptor file(i->second, _basePath);
+		file.writeEncrypted(data, _localKey);
+	}
 }
 
 void Account::clearDraftCursors(PeerId peerId) {
@@ -1207,8 +1501,9 @@ void Account::clearDraftCursors(PeerId peerId) {
 	if (i != _draftCursorsMap.cend()) {
 		ClearKey(i->second, _basePath);
 		_draftCursorsMap.erase(i);
-		writeMapDelayed();
+		journalMapChange(lskDraftPosition, peerId, 0);
 	}
+	_draftCursorsWritten.remove(peerId);
 }
 
 void Account::readDraftCursors(PeerId peerId, Data::HistoryDrafts &map) {
@@ -1462,6 +1757,7 @@ void Account::writeFileLocation(MediaKey location, const Core::FileLocation &loc
 	if (local.fname.isEmpty()) {
 		return;
 	}
+	ensureLocationsRead();
 	if (!local.inMediaCache()) {
 		const auto aliasIt = _fileLocationAliases.constFind(location);
 		if (aliasIt != _fileLocationAliases.cend()) {
@@ -1473,7 +1769,7 @@ void Account::writeFileLocation(MediaKey location, const Core::FileLocation &loc
 			if (i.value().second == local) {
 				if (i.value().first != location) {
 					_fileLocationAliases.insert(location, i.value().first);
-					writeLocationsQueued();
+					writeLocationsDelayed();
 				}
 				return;
 			}
@@ -1497,10 +1793,11 @@ void Account::writeFileLocation(MediaKey location, const Core::FileLocation &loc
 		}
 	}
 	_fileLocations.insert(location, local);
-	writeLocationsQueued();
+	writeLocationsDelayed();
 }
 
 void Account::removeFileLocation(MediaKey location) {
+	ensureLocationsRead();
 	auto i = _fileLocations.find(location);
 	if (i == _fileLocations.end()) {
 		return;
@@ -1508,10 +1805,11 @@ void Account::removeFileLocation(MediaKey location) {
 	while (i != _fileLocations.end() && (i.key() == location)) {
 		i = _fileLocations.erase(i);
 	}
-	writeLocationsQueued();
+	writeLocationsDelayed();
 }
 
 Core::FileLocation Account::readFileLocation(MediaKey location) {
+	ensureLocationsRead();
 	const auto aliasIt = _fileLocationAliases.constFind(location);
 	if (aliasIt != _fileLocationAliases.cend()) {
 		location = aliasIt.value();
@@ -1609,28 +1907,63 @@ void Account::writeStickerSet(
 	if (set.flags & SetFlag::NotLoaded) {
 		writeInfo(-set.count);
 		return;
+	} else if (KeepLocalStickers(set)) {
+		writeInfo(set.localStickersCount);
+		stream << set.localStickers;
+		return;
 	} else if (set.stickers.isEmpty()) {
 		return;
 	}
 
 	writeInfo(set.stickers.size());
-	for (const auto &sticker : set.stickers) {
-		Serialize::Document::writeToStream(stream, sticker);
+
+	// Stickers are written as a separate byte array, so that the sets
+	// list can be read without parsing all the documents in it.
+	auto serialized = QByteArray();
+	serialized.reserve(stickerSetStickersSize(set));
+	{
+		QDataStream inner(&serialized, QIODevice::WriteOnly);
+		inner.setVersion(QDataStream::Qt_5_1);
+		for (const auto &sticker : set.stickers) {
+			Serialize::Document::writeToStream(inner, sticker);
+		}
+		inner << qint32(set.dates.size());
+		if (!set.dates.empty()) {
+			Assert(set.dates.size() == set.stickers.size());
+			for (const auto date : set.dates) {
+				inner << qint32(date);
+			}
+		}
+		inner << qint32(set.emoji.size());
+		for (auto j = set.emoji.cbegin(), e = set.emoji.cend(); j != e; ++j) {
+			inner << j.key()->id() << qint32(j->size());
+			for (const auto sticker : *j) {
+				inner << quint64(sticker->id);
+			}
+		}
 	}
-	stream << qint32(set.dates.size());
+	stream << serialized;
+}
+
+int Account::stickerSetStickersSize(const Data::StickersSet &set) const {
+	auto result = 0;
+	for (const auto sticker : std::as_const(set.stickers)) {
+		result += Serialize::Document::sizeInStream(sticker);
+	}
+
+	result += sizeof(qint32); // datesCount
 	if (!set.dates.empty()) {
-		Assert(set.dates.size() == set.stickers.size());
-		for (const auto date : set.dates) {
-			stream << qint32(date);
-		}
+		Assert(set.stickers.size() == set.dates.size());
+		result += set.dates.size() * sizeof(qint32);
 	}
-	stream << qint32(set.emoji.size());
+
+	result += sizeof(qint32); // emojiCount
 	for (auto j = set.emoji.cbegin(), e = set.emoji.cend(); j != e; ++j) {
-		stream << j.key()->id() << qint32(j->size());
-		for (const auto sticker : *j) {
-			stream << quint64(sticker->id);
-		}
+		result += Serialize::stringSize(j.key()->id())
+			+ sizeof(qint32)
+			+ (j->size() * sizeof(quint64));
 	}
+	return result;
 }
 
 // In generic method _writeStickerSets() we look through all the sets and call a
@@ -1649,6 +1982,15 @@ void Account::writeStickerSets(
 		const Data::StickersSetsOrder &order) {
 	using SetFlag = Data::StickersSetFlag;
 
+	// Lazily read sets are written back as they were read, unless the
+	// documents in them were serialized by a different app version.
+	for (const auto &[id, set] : _owner->session().data().stickers().setsRef()) {
+		if (!set->localStickers.isEmpty()
+			&& set->localStickersVersion != AppVersion) {
+			materializeStickerSet(set.get());
+		}
+	}
+
 	const auto &sets = _owner->session().data().stickers().sets();
 	if (sets.empty()) {
 		if (stickersKey) {
@@ -1682,20 +2024,9 @@ void Account::writeStickerSets(
 			continue;
 		}
 
-		for (const auto sticker : std::as_const(raw->stickers)) {
-			size += Serialize::Document::sizeInStream(sticker);
-		}
-
-		size += sizeof(qint32); // datesCount
-		if (!raw->dates.empty()) {
-			Assert(raw->stickers.size() == raw->dates.size());
-			size += raw->dates.size() * sizeof(qint32);
-		}
-
-		size += sizeof(qint32); // emojiCount
-		for (auto j = raw->emoji.cbegin(), e = raw->emoji.cend(); j != e; ++j) {
-			size += Serialize::stringSize(j.key()->id()) + sizeof(qint32) + (j->size() * sizeof(quint64));
-		}
+		size += sizeof(quint32) + (KeepLocalStickers(*raw)
+			? raw->localStickers.size()
+			: stickerSetStickersSize(*raw));
 
 		++setsCount;
 	}
@@ -1733,10 +2064,128 @@ void Account::writeStickerSets(
 	file.writeEncrypted(data, _localKey);
 }
 
+void Account::materializeStickerSet(not_null<Data::StickersSet*> set) {
+	auto serialized = base::take(set->localStickers);
+	const auto version = base::take(set->localStickersVersion);
+	base::take(set->localStickersCount);
+	if (serialized.isEmpty() || !set->stickers.isEmpty()) {
+		// Already received newer stickers from the server.
+		return;
+	}
+	const auto count = set->count;
+	QDataStream stream(&serialized, QIODevice::ReadOnly);
+	stream.setVersion(QDataStream::Qt_5_1);
+	if (!readStickerSetStickers(stream, version, set, count, true)) {
+		LOG(("App Error: could not read local stickers of set %1."
+			).arg(set->id));
+		set->stickers.clear();
+		set->dates.clear();
+		set->emoji.clear();
+		set->count = count;
+		set->flags |= Data::StickersSetFlag::NotLoaded;
+	}
+}
+
+bool Account::readStickerSetStickers(
+		QDataStream &stream,
+		int32 version,
+		not_null<Data::StickersSet*> set,
+		int count,
+		bool fillStickers) {
+	using SetFlag = Data::StickersSetFlag;
+
+	const auto inputSet = set->identifier();
+	if (fillStickers) {
+		set->stickers.reserve(count);
+		set->count = 0;
+	}
+
+	Serialize::Document::StickerSetInfo info(
+		set->id,
+		set->accessHash,
+		set->shortName);
+	base::flat_set<DocumentId> read;
+	for (int32 j = 0; j < count; ++j) {
+		auto document = Serialize::Document::readStickerFromStream(
+			&_owner->session(),
+			version,
+			stream, info);
+		if (!CheckStreamStatus(stream)) {
+			return false;
+		} else if (!document
+			|| !document->sticker()
+			|| read.contains(document->id)) {
+			continue;
+		}
+		read.emplace(document->id);
+		if (fillStickers) {
+			set->stickers.push_back(document);
+			if (!(set->flags & SetFlag::Special)) {
+				if (!document->sticker()->set.id) {
+					document->sticker()->set = inputSet;
+				}
+			}
+			++set->count;
+		}
+	}
+
+	qint32 datesCount = 0;
+	stream >> datesCount;
+	if (datesCount > 0) {
+		if (datesCount != count) {
+			return false;
+		}
+		const auto fillDates =
+			((set->id == Data::Stickers::CloudRecentSetId)
+				|| (set->id == Data::Stickers::CloudRecentAttachedSetId))
+			&& (set->stickers.size() == datesCount);
+		if (fillDates) {
+			set->dates.clear();
+			set->dates.reserve(datesCount);
+		}
+		for (auto i = 0; i != datesCount; ++i) {
+			qint32 date = 0;
+			stream >> date;
+			if (fillDates) {
+				set->dates.push_back(TimeId(date));
+			}
+		}
+	}
+
+	qint32 emojiCount = 0;
+	stream >> emojiCount;
+	if (!CheckStreamStatus(stream) || emojiCount < 0) {
+		return false;
+	}
+	for (int32 j = 0; j < emojiCount; ++j) {
+		QString emojiString;
+		qint32 stickersCount;
+		stream >> emojiString >> stickersCount;
+		Data::StickersPack pack;
+		pack.reserve(stickersCount);
+		for (int32 k = 0; k < stickersCount; ++k) {
+			quint64 id;
+			stream >> id;
+			const auto doc = _owner->session().data().document(id);
+			if (!doc->sticker()) continue;
+
+			pack.push_back(doc);
+		}
+		if (fillStickers) {
+			if (auto emoji = Ui::Emoji::Find(emojiString)) {
+				emoji = emoji->original();
+				set->emoji.insert(emoji, pack);
+			}
+		}
+	}
+	return CheckStreamStatus(stream);
+}
+
 void Account::readStickerSets(
 		FileKey &stickersKey,
 		Data::StickersSetsOrder *outOrder,
-		Data::StickersSetFlags readingFlags) {
+		Data::StickersSetFlags readingFlags,
+		bool lazy) {
 	using SetFlag = Data::StickersSetFlag;
 
 	FileReadDescriptor stickers;
@@ -1759,7 +2208,8 @@ void Account::readStickerSets(
 	qint32 version = 0;
 	stickers.stream >> versionTag >> version;
 	if (versionTag != kStickersVersionTag
-		|| version != kStickersSerializeVersion) {
+		|| (version != kStickersSerializeVersion
+			&& version != kStickersSerializeVersionInline)) {
 		// Old data, without sticker set thumbnails.
 		return failed();
 	}
@@ -1836,8 +2286,8 @@ void Account::readStickerSets(
 				ImageWithLocation{ .location = setThumbnail });
 		}
 		const auto set = it->second.get();
-		const auto inputSet = set->identifier();
-		const auto fillStickers = set->stickers.isEmpty();
+		const auto fillStickers = set->stickers.isEmpty()
+			&& set->localStickers.isEmpty();
 
 		if (scnt < 0) { // disabled not loaded set
 			if (!set->count || fillStickers) {
@@ -1846,88 +2296,41 @@ void Account::readStickerSets(
 			continue;
 		}
 
-		if (fillStickers) {
-			set->stickers.reserve(scnt);
-			set->count = 0;
-		}
-
-		Serialize::Document::StickerSetInfo info(
-			setId,
-			setAccessHash,
-			setShortName);
-		base::flat_set<DocumentId> read;
-		for (int32 j = 0; j < scnt; ++j) {
-			auto document = Serialize::Document::readStickerFromStream(
-				&_owner->session(),
+		if (version == kStickersSerializeVersionInline) {
+			const auto ok = readStickerSetStickers(
+				stickers.stream,
 				stickers.version,
-				stickers.stream, info);
-			if (!CheckStreamStatus(stickers.stream)) {
-				return failed();
-			} else if (!document
-				|| !document->sticker()
-				|| read.contains(document->id)) {
-				continue;
-			}
-			read.emplace(document->id);
-			if (fillStickers) {
-				set->stickers.push_back(document);
-				if (!(set->flags & SetFlag::Special)) {
-					if (!document->sticker()->set.id) {
-						document->sticker()->set = inputSet;
-					}
-				}
-				++set->count;
-			}
-		}
-
-		qint32 datesCount = 0;
-		stickers.stream >> datesCount;
-		if (datesCount > 0) {
-			if (datesCount != scnt) {
+				set,
+				scnt,
+				fillStickers);
+			if (!ok) {
 				return failed();
 			}
-			const auto fillDates =
-				((set->id == Data::Stickers::CloudRecentSetId)
-					|| (set->id == Data::Stickers::CloudRecentAttachedSetId))
-				&& (set->stickers.size() == datesCount);
-			if (fillDates) {
-				set->dates.clear();
-				set->dates.reserve(datesCount);
-			}
-			for (auto i = 0; i != datesCount; ++i) {
-				qint32 date = 0;
-				stickers.stream >> date;
-				if (fillDates) {
-					set->dates.push_back(TimeId(date));
-				}
-			}
+			continue;
 		}
-
-		qint32 emojiCount = 0;
-		stickers.stream >> emojiCount;
-		if (!CheckStreamStatus(stickers.stream) || emojiCount < 0) {
+		auto serialized = QByteArray();
+		stickers.stream >> serialized;
+		if (!CheckStreamStatus(stickers.stream)) {
 			return failed();
+		} else if (!fillStickers) {
+			continue;
+		} else if (lazy) {
+			// Documents will be read on the first access to this set.
+			set->count = scnt;
+			set->localStickers = std::move(serialized);
+			set->localStickersVersion = stickers.version;
+			set->localStickersCount = scnt;
+			continue;
 		}
-		for (int32 j = 0; j < emojiCount; ++j) {
-			QString emojiString;
-			qint32 stickersCount;
-			stickers.stream >> emojiString >> stickersCount;
-			Data::StickersPack pack;
-			pack.reserve(stickersCount);
-			for (int32 k = 0; k < stickersCount; ++k) {
-				quint64 id;
-				stickers.stream >> id;
-				const auto doc = _owner->session().data().document(id);
-				if (!doc->sticker()) continue;
-
-				pack.push_back(doc);
-			}
-			if (fillStickers) {
-				if (auto emoji = Ui::Emoji::Find(emojiString)) {
-					emoji = emoji->original();
-					set->emoji.insert(emoji, pack);
-				}
-			}
+		QDataStream inner(&serialized, QIODevice::ReadOnly);
+		inner.setVersion(QDataStream::Qt_5_1);
+		if (!readStickerSetStickers(
+				inner,
+				stickers.version,
+				set,
+				scnt,
+				true)) {
+			return failed();
 		}
 	}
 
@@ -1979,7 +2382,7 @@ void Account::writeInstalledStickers() {
 			// separate files for them
 			return StickerSetCheckResult::Skip;
 		} else if (set.flags & SetFlag::Special) {
-			if (set.stickers.isEmpty()) { // all other special are "installed"
+			if (NoStickersToWrite(set)) { // all other special are "installed"
 				return StickerSetCheckResult::Skip;
 			}
 		} else if (!(set.flags & SetFlag::Installed)
@@ -1990,7 +2393,7 @@ void Account::writeInstalledStickers() {
 		} else if (set.flags & SetFlag::NotLoaded) {
 			// waiting to receive
 			return StickerSetCheckResult::Abort;
-		} else if (set.stickers.isEmpty()) {
+		} else if (NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2012,7 +2415,7 @@ void Account::writeFeaturedStickers() {
 			return StickerSetCheckResult::Skip;
 		} else if (set.flags & SetFlag::NotLoaded) { // waiting to receive
 			return StickerSetCheckResult::Abort;
-		} else if (set.stickers.isEmpty()) {
+		} else if (NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2022,7 +2425,7 @@ void Account::writeFeaturedStickers() {
 void Account::writeRecentStickers() {
 	writeStickerSets(_recentStickersKey, [](const Data::StickersSet &set) {
 		if (set.id != Data::Stickers::CloudRecentSetId
-			|| set.stickers.isEmpty()) {
+			|| NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2031,7 +2434,7 @@ void Account::writeRecentStickers() {
 
 void Account::writeFavedStickers() {
 	writeStickerSets(_favedStickersKey, [](const Data::StickersSet &set) {
-		if (set.id != Data::Stickers::FavedSetId || set.stickers.isEmpty()) {
+		if (set.id != Data::Stickers::FavedSetId || NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2046,7 +2449,7 @@ void Account::writeArchivedStickers() {
 			return StickerSetCheckResult::Skip;
 		}
 		if (!(set.flags & SetFlag::Archived)
-			|| set.stickers.isEmpty()) {
+			|| NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2060,7 +2463,7 @@ void Account::writeArchivedMasks() {
 		if (!(set.flags & SetFlag::Masks)) {
 			return StickerSetCheckResult::Skip;
 		}
-		if (!(set.flags & SetFlag::Archived) || set.stickers.isEmpty()) {
+		if (!(set.flags & SetFlag::Archived) || NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2071,7 +2474,7 @@ void Account::writeInstalledMasks() {
 	using SetFlag = Data::StickersSetFlag;
 
 	writeStickerSets(_installedMasksKey, [](const Data::StickersSet &set) {
-		if (!(set.flags & SetFlag::Masks) || set.stickers.isEmpty()) {
+		if (!(set.flags & SetFlag::Masks) || NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2081,7 +2484,7 @@ void Account::writeInstalledMasks() {
 void Account::writeRecentMasks() {
 	writeStickerSets(_recentMasksKey, [](const Data::StickersSet &set) {
 		if (set.id != Data::Stickers::CloudRecentAttachedSetId
-			|| set.stickers.isEmpty()) {
+			|| NoStickersToWrite(set)) {
 			return StickerSetCheckResult::Skip;
 		}
 		return StickerSetCheckResult::Write;
@@ -2220,10 +2623,13 @@ void Account::readInstalledStickers() {
 }
 
 void Account::readFeaturedStickers() {
+	// Featured sets are shown only in the trending sections,
+	// so their documents are read when those are first displayed.
 	readStickerSets(
 		_featuredStickersKey,
 		&_owner->session().data().stickers().featuredSetsOrderRef(),
-		Data::StickersSetFlag::Featured);
+		Data::StickersSetFlag::Featured,
+		true);
 
 	const auto &sets = _owner->session().data().stickers().sets();
 	const auto &order = _owner->session().data().stickers().featuredSetsOrder();
@@ -2256,7 +2662,9 @@ void Account::readArchivedStickers() {
 	if (!archivedStickersRead) {
 		readStickerSets(
 			_archivedStickersKey,
-			&_owner->session().data().stickers().archivedSetsOrderRef());
+			&_owner->session().data().stickers().archivedSetsOrderRef(),
+			Data::StickersSetFlags(),
+			true);
 		archivedStickersRead = true;
 	}
 }
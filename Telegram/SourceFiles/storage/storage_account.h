@@ -42,6 +42,7 @@ namespace Storage {
 namespace details {
 struct ReadSettingsContext;
 struct FileReadDescriptor;
+class FileReadPrefetch;
 } // namespace details
 
 class EncryptionKey;
@@ -104,7 +105,7 @@ public:
 	void removeFileLocation(MediaKey location);
 
 	void updateDownloads(Fn<std::optional<QByteArray>()> downloadsSerialize);
-	[[nodiscard]] QByteArray downloadsSerialized() const;
+	[[nodiscard]] QByteArray downloadsSerialized();
 
 	[[nodiscard]] EncryptionKey cacheKey() const;
 	[[nodiscard]] QString cachePath() const;
@@ -128,6 +129,7 @@ public:
 	void readRecentStickers();
 	void readFavedStickers();
 	void readArchivedStickers();
+	void materializeStickerSet(not_null<Data::StickersSet*> set);
 	void readArchivedMasks();
 	void writeSavedGifs();
 	void readSavedGifs();
@@ -186,6 +188,13 @@ private:
 	};
 	friend inline constexpr bool is_flag_type(BotTrustFlag) { return true; };
 
+	struct MapJournalEntry {
+		quint64 generation = 0;
+		quint32 keyType = 0;
+		PeerId peerId = 0;
+		FileKey key = 0; // Zero means the key was removed.
+	};
+
 	[[nodiscard]] base::flat_set<QString> collectGoodNames() const;
 	[[nodiscard]] auto prepareReadSettingsContext() const
 		-> details::ReadSettingsContext;
@@ -197,15 +206,27 @@ private:
 	void writeMapDelayed();
 	void writeMapQueued();
 	void writeMap();
-
+	void readMapJournal(
+		const MTP::AuthKeyPtr &localKey,
+		quint64 mapGeneration,
+		base::flat_map<PeerId, FileKey> &draftsMap,
+		base::flat_map<PeerId, FileKey> &draftCursorsMap,
+		base::flat_map<PeerId, bool> &draftsNotReadMap);
+	void journalMapChange(quint32 keyType, PeerId peerId, FileKey key);
+	[[nodiscard]] QByteArray serializeMapJournalEntry(
+		const MapJournalEntry &entry) const;
+	void appendMapJournal(const MapJournalEntry &entry);
+	void writeMapJournal();
+
+	void ensureLocationsRead();
 	void readLocations();
 	void writeLocations();
-	void writeLocationsQueued();
 	void writeLocationsDelayed();
 
 	std::unique_ptr<Main::SessionSettings> readSessionSettings();
 	void writeSessionSettings(Main::SessionSettings *stored);
 
+	void prefetchStartFiles();
 	std::unique_ptr<MTP::Config> readMtpConfig();
 	void readMtpData();
 	std::unique_ptr<Main::SessionSettings> applyReadContext(
@@ -231,10 +252,19 @@ private:
 		FileKey &stickersKey,
 		CheckSet checkSet,
 		const Data::StickersSetsOrder &order);
+	[[nodiscard]] int stickerSetStickersSize(
+		const Data::StickersSet &set) const;
 	void readStickerSets(
 		FileKey &stickersKey,
 		Data::StickersSetsOrder *outOrder = nullptr,
-		Data::StickersSetFlags readingFlags = 0);
+		Data::StickersSetFlags readingFlags = 0,
+		bool lazy = false);
+	[[nodiscard]] bool readStickerSetStickers(
+		QDataStream &stream,
+		int32 version,
+		not_null<Data::StickersSet*> set,
+		int count,
+		bool fillStickers);
 	void importOldRecentStickers();
 
 	void readTrustedBots();
@@ -255,6 +285,8 @@ private:
 
 	base::flat_map<PeerId, FileKey> _draftsMap;
 	base::flat_map<PeerId, FileKey> _draftCursorsMap;
+	base::flat_map<PeerId, QByteArray> _draftsWritten;
+	base::flat_map<PeerId, QByteArray> _draftCursorsWritten;
 	base::flat_map<PeerId, bool> _draftsNotReadMap;
 	base::flat_map<
 		not_null<History*>,
@@ -296,11 +328,18 @@ private:
 	bool _recentHashtagsAndBotsWereRead = false;
 
 	int _oldMapVersion = 0;
+	quint64 _mapGeneration = 0;
+	std::vector<MapJournalEntry> _mapJournal;
 
 	base::Timer _writeMapTimer;
 	base::Timer _writeLocationsTimer;
 	bool _mapChanged = false;
 	bool _locationsChanged = false;
+	bool _locationsRead = false;
+
+	std::unique_ptr<details::FileReadPrefetch> _mtpDataPrefetch;
+	std::unique_ptr<details::FileReadPrefetch> _mtpConfigPrefetch;
+	std::unique_ptr<details::FileReadPrefetch> _settingsPrefetch;
 
 };
 
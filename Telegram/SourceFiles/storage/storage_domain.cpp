@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtproto_config.h"
 #include "main/main_domain.h"
 #include "main/main_account.h"
+#include "core/startup_trace.h"
 #include "base/random.h"
 
 namespace Storage {
@@ -180,6 +181,7 @@ Domain::StartModernResult Domain::startModern(
 				_owner,
 				_dataName,
 				index);
+			const auto span = Core::StartupTrace::Span("Main::Account::start");
 			auto config = account->prepareToStart(_localKey);
 			const auto sessionId = account->willHaveSessionUniqueId(
 				config.get());
@@ -0,0 +1,131 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "storage/storage_file_parts_reader.h"
+
+namespace Storage {
+namespace {
+
+constexpr auto kReadAheadParts = 4;
+
+} // namespace
+
+class FilePartsReader::Worker final {
+public:
+	Worker(
+		crl::weak_on_queue<Worker> weak,
+		base::weak_ptr<FilePartsReader> owner,
+		const QString &path,
+		int partSize);
+
+	void read(int count);
+
+private:
+	const base::weak_ptr<FilePartsReader> _owner;
+	const int _partSize = 0;
+	QFile _file;
+	bool _opened = false;
+	bool _failed = false;
+
+};
+
+FilePartsReader::Worker::Worker(
+	crl::weak_on_queue<Worker> weak,
+	base::weak_ptr<FilePartsReader> owner,
+	const QString &path,
+	int partSize)
+: _owner(owner)
+, _partSize(partSize)
+, _file(path) {
+}
+
+void FilePartsReader::Worker::read(int count) {
+	const auto owner = _owner;
+	if (_failed) {
+		return;
+	} else if (!_opened) {
+		_opened = true;
+		if (!_file.open(QIODevice::ReadOnly)) {
+			_failed = true;
+			crl::on_main(owner, [=] {
+				owner.get()->readFailed();
+			});
+			return;
+		}
+	}
+	for (auto i = 0; i != count; ++i) {
+		auto bytes = _file.read(_partSize);
+		if (bytes.isEmpty() && _file.error() != QFileDevice::NoError) {
+			_failed = true;
+			crl::on_main(owner, [=] {
+				owner.get()->readFailed();
+			});
+			return;
+		}
+		crl::on_main(owner, [=, bytes = std::move(bytes)]() mutable {
+			owner.get()->partRead(std::move(bytes));
+		});
+	}
+}
+
+FilePartsReader::FilePartsReader(
+	const QString &path,
+	int partSize,
+	Fn<void()> partsReady)
+: _partsReady(std::move(partsReady))
+, _worker(base::make_weak(this), path, partSize) {
+	requestMore();
+}
+
+FilePartsReader::~FilePartsReader() = default;
+
+std::optional<QByteArray> FilePartsReader::takeNextPart() {
+	if (_ready.empty()) {
+		return std::nullopt;
+	}
+	auto result = std::move(_ready.front());
+	_ready.pop_front();
+	requestMore();
+	return result;
+}
+
+bool FilePartsReader::failed() const {
+	return _failed;
+}
+
+void FilePartsReader::requestMore() {
+	const auto count = kReadAheadParts - int(_ready.size()) - _requested;
+	if (_failed || count <= 0) {
+		return;
+	}
+	_requested += count;
+	_worker.with([=](Worker &worker) {
+		worker.read(count);
+	});
+}
+
+void FilePartsReader::partRead(QByteArray &&bytes) {
+	Expects(_requested > 0);
+
+	--_requested;
+	_ready.push_back(std::move(bytes));
+	notifyPartsReady();
+}
+
+void FilePartsReader::readFailed() {
+	_failed = true;
+	notifyPartsReady();
+}
+
+void FilePartsReader::notifyPartsReady() {
+	// The callback may destroy this reader, so call it from a copy.
+	if (const auto callback = _partsReady) {
+		callback();
+	}
+}
+
+} // namespace Storage
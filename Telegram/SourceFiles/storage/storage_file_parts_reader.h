@@ -0,0 +1,47 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/weak_ptr.h"
+
+#include <crl/crl_object_on_queue.h>
+
+namespace Storage {
+
+// Reads a file in fixed size parts on a background queue, keeping
+// a bounded amount of parts read ahead of the consumer.
+class FilePartsReader final : public base::has_weak_ptr {
+public:
+	FilePartsReader(
+		const QString &path,
+		int partSize,
+		Fn<void()> partsReady);
+	~FilePartsReader();
+
+	// Returns std::nullopt if the next part was not read yet,
+	// partsReady() callback will be called when it is available.
+	[[nodiscard]] std::optional<QByteArray> takeNextPart();
+	[[nodiscard]] bool failed() const;
+
+private:
+	class Worker;
+
+	void requestMore();
+	void partRead(QByteArray &&bytes);
+	void readFailed();
+	void notifyPartsReady();
+
+	const Fn<void()> _partsReady;
+	crl::object_on_queue<Worker> _worker;
+	std::deque<QByteArray> _ready;
+	int _requested = 0;
+	bool _failed = false;
+
+};
+
+} // namespace Storage
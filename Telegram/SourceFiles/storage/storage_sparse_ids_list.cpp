@@ -8,6 +8,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_sparse_ids_list.h"
 
 namespace Storage {
+namespace {
+
+// Merging re-sorts the whole slice, inserting a few ids is cheaper.
+constexpr auto kInsertOneByOneMax = 8;
+
+} // namespace
 
 SparseIdsList::Slice::Slice(
 	base::flat_set<MsgId> &&messages,
@@ -23,7 +29,16 @@ void SparseIdsList::Slice::merge(
 	Expects(moreNoSkipRange.from <= range.till);
 	Expects(range.from <= moreNoSkipRange.till);
 
-	messages.merge(std::begin(moreMessages), std::end(moreMessages));
+	const auto moreCount = std::distance(
+		std::begin(moreMessages),
+		std::end(moreMessages));
+	if (moreCount <= kInsertOneByOneMax) {
+		for (const auto id : moreMessages) {
+			messages.emplace(id);
+		}
+	} else {
+		messages.merge(std::begin(moreMessages), std::end(moreMessages));
+	}
 	range = {
 		qMin(range.from, moreNoSkipRange.from),
 		qMax(range.till, moreNoSkipRange.till)
@@ -35,6 +35,10 @@ int SendPreloadRequest(not_null<History*> history, Fn<void()> retry) {
 	const auto minId = 0;
 	const auto historyHash = uint64(0);
 	const auto type = Data::Histories::RequestType::History;
+
+	// Warm up the chat header as well, not only the messages.
+	history->peer->loadUserpic();
+
 	auto &histories = history->owner().histories();
 	return histories.sendRequest(history, type, [=](Fn<void()> finish) {
 		return history->session().api().request(MTPmessages_GetHistory(
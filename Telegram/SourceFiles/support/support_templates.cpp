@@ -440,6 +440,18 @@ int CountMaxKeyLength(const TemplatesData &data) {
 	return result;
 }
 
+TemplatesKeys ComputeKeys(const TemplatesData &data) {
+	auto result = TemplatesKeys();
+	for (const auto &[path, file] : data.files) {
+		for (const auto &[normalized, question] : file.questions) {
+			for (const auto &key : question.normalizedKeys) {
+				result.emplace(key, TemplatesIndex::Id{ path, normalized });
+			}
+		}
+	}
+	return result;
+}
+
 } // namespace
 } // namespace details
 
@@ -506,6 +518,11 @@ void Templates::load() {
 
 void Templates::setData(TemplatesData &&data) {
 	_data = std::move(data);
+	refreshKeys();
+}
+
+void Templates::refreshKeys() {
+	_keys = ComputeKeys(_data);
 	_maxKeyLength = CountMaxKeyLength(_data);
 }
 
@@ -597,6 +614,7 @@ void Templates::updateRequestFinished(QNetworkReply *reply) {
 				_session->data().serviceNotification({ full });
 			}
 			_data.files.at(path) = std::move(one.files.at(path));
+			refreshKeys();
 
 			_updates->requests.erase(path);
 			checkUpdateFinished();
@@ -622,16 +640,15 @@ auto Templates::matchExact(QString query) const
 
 	query = NormalizeKey(query);
 
-	for (const auto &[path, file] : _data.files) {
-		for (const auto &[normalized, question] : file.questions) {
-			for (const auto &key : question.normalizedKeys) {
-				if (key == query) {
-					return QuestionByKey{ question, key };
-				}
-			}
-		}
+	const auto i = _keys.find(query);
+	if (i == end(_keys)) {
+		return {};
 	}
-	return {};
+	const auto &[path, normalized] = i->second;
+	return QuestionByKey{
+		_data.files.at(path).questions.at(normalized),
+		i->first,
+	};
 }
 
 auto Templates::matchFromEnd(QString query) const
@@ -647,19 +664,19 @@ auto Templates::matchFromEnd(QString query) const
 		queries.push_back(NormalizeKey(query.mid(size - i - 1)));
 	}
 
-	auto result = std::optional<QuestionByKey>();
-	for (const auto &[path, file] : _data.files) {
-		for (const auto &[normalized, question] : file.questions) {
-			for (const auto &key : question.normalizedKeys) {
-				if (key.size() <= queries.size()
-					&& queries[key.size() - 1] == key
-					&& (!result || result->key.size() <= key.size())) {
-					result = QuestionByKey{ question, key };
-				}
-			}
+	// Longest suffix that is a known key wins. Normalizing may change
+	// the length, so the key must be as long as the suffix it came from.
+	for (auto i = size; i != 0; --i) {
+		const auto j = _keys.find(queries[i - 1]);
+		if (j != end(_keys) && j->first.size() == i) {
+			const auto &[path, normalized] = j->second;
+			return QuestionByKey{
+				_data.files.at(path).questions.at(normalized),
+				j->first,
+			};
 		}
 	}
-	return result;
+	return {};
 }
 
 Templates::~Templates() = default;
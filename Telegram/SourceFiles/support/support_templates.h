@@ -42,6 +42,8 @@ struct TemplatesIndex {
 	std::map<Id, std::vector<Term>> full;
 };
 
+using TemplatesKeys = std::map<QString, TemplatesIndex::Id>;
+
 } // namespace details
 
 class Templates : public base::has_weak_ptr {
@@ -78,11 +80,13 @@ private:
 	void updateRequestFinished(QNetworkReply *reply);
 	void checkUpdateFinished();
 	void setData(details::TemplatesData &&data);
+	void refreshKeys();
 
 	not_null<Main::Session*> _session;
 
 	details::TemplatesData _data;
 	details::TemplatesIndex _index;
+	details::TemplatesKeys _keys;
 	rpl::event_stream<QStringList> _errors;
 	base::binary_guard _reading;
 	bool _reloadAfterRead = false;
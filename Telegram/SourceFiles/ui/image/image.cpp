@@ -12,11 +12,24 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session.h"
 #include "ui/ui_utility.h"
 
+#include <atomic>
+
 using namespace Images;
 
 namespace Images {
 namespace {
 
+// Drop all cached sizes of an image if it is asked for too many of them.
+constexpr auto kPixCacheLimit = 8;
+
+std::atomic<int64> DecodedImages = 0;
+std::atomic<int64> DecodedImageBytes = 0;
+std::atomic<int64> DecodedCacheBytes = 0;
+
+[[nodiscard]] int64 PixmapBytes(const QPixmap &pixmap) {
+	return int64(pixmap.width()) * pixmap.height() * 4;
+}
+
 [[nodiscard]] uint64 PixKey(int width, int height, Options options) {
 	return static_cast<uint64>(width)
 		| (static_cast<uint64>(height) << 24)
@@ -41,6 +54,14 @@ namespace {
 
 } // namespace
 
+DecodedStats CurrentDecodedStats() {
+	return {
+		.images = DecodedImages.load(),
+		.imageBytes = DecodedImageBytes.load(),
+		.cacheBytes = DecodedCacheBytes.load(),
+	};
+}
+
 QByteArray ExpandInlineBytes(const QByteArray &bytes) {
 	if (bytes.size() < 3 || bytes[0] != '\x01') {
 		return QByteArray();
@@ -308,6 +329,17 @@ Image::Image(const QByteArray &content)
 Image::Image(QImage &&data)
 : _data(data.isNull() ? Empty()->original() : std::move(data)) {
 	Expects(!_data.isNull());
+
+	++DecodedImages;
+	DecodedImageBytes += _data.sizeInBytes();
+}
+
+Image::~Image() {
+	--DecodedImages;
+	DecodedImageBytes -= _data.sizeInBytes();
+	for (const auto &[key, pixmap] : _cache) {
+		DecodedCacheBytes -= PixmapBytes(pixmap);
+	}
 }
 
 not_null<Image*> Image::Empty() {
@@ -361,9 +393,21 @@ const QPixmap &Image::cached(
 	const auto size = outer.isEmpty() ? QSize(w, h) : outer * ratio;
 	const auto k = single ? SinglePixKey(args) : PixKey(w, h, args);
 	const auto i = _cache.find(k);
-	return (i != _cache.cend() && i->second.size() == size)
-		? i->second
-		: _cache.emplace_or_assign(k, prepare(w, h, args)).first->second;
+	if (i != _cache.cend() && i->second.size() == size) {
+		return i->second;
+	} else if (i != _cache.cend()) {
+		DecodedCacheBytes -= PixmapBytes(i->second);
+	} else if (_cache.size() >= kPixCacheLimit) {
+		for (const auto &[key, pixmap] : _cache) {
+			DecodedCacheBytes -= PixmapBytes(pixmap);
+		}
+		_cache.clear();
+	}
+	auto &result = _cache.emplace_or_assign(
+		k,
+		prepare(w, h, args)).first->second;
+	DecodedCacheBytes += PixmapBytes(result);
+	return result;
 }
 
 QPixmap Image::prepare(int w, int h, const Images::PrepareArgs &args) const {
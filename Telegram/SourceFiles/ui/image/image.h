@@ -13,6 +13,13 @@ class QPainterPath;
 
 namespace Images {
 
+struct DecodedStats {
+	int64 images = 0;
+	int64 imageBytes = 0;
+	int64 cacheBytes = 0;
+};
+[[nodiscard]] DecodedStats CurrentDecodedStats();
+
 [[nodiscard]] QByteArray ExpandInlineBytes(const QByteArray &bytes);
 [[nodiscard]] QImage FromInlineBytes(const QByteArray &bytes);
 [[nodiscard]] QPainterPath PathFromInlineBytes(const QByteArray &bytes);
@@ -24,6 +31,7 @@ public:
 	explicit Image(const QString &path);
 	explicit Image(const QByteArray &content);
 	explicit Image(QImage &&data);
+	~Image();
 
 	[[nodiscard]] static not_null<Image*> Empty(); // 1x1 transparent
 	[[nodiscard]] static not_null<Image*> BlankMedia(); // 1x1 black
@@ -315,7 +315,14 @@ MainWindow::MainWindow(not_null<Controller*> controller)
 		updatePalette();
 	}, lifetime());
 
+	// Badge changes fire for every unread state change, but the title
+	// and the icons depend only on the counter and its muted state.
 	Core::App().unreadBadgeChanges(
+	) | rpl::map([] {
+		return std::make_pair(
+			Core::App().unreadBadge(),
+			Core::App().unreadBadgeMuted());
+	}) | rpl::distinct_until_changed(
 	) | rpl::start_with_next([=] {
 		updateUnreadCounter();
 	}, lifetime());
@@ -349,7 +349,24 @@ void Manager::removeWidget(internal::Widget *remove) {
 }
 
 void Manager::doShowNotification(NotificationFields &&fields) {
-	_queuedNotifications.emplace_back(std::move(fields));
+	auto queued = QueuedNotification(std::move(fields));
+	const auto plain = [](const QueuedNotification &notification) {
+		return notification.reaction.isEmpty()
+			&& (notification.forwardedCount < 2);
+	};
+	if (plain(queued)) {
+		// In a burst of messages display only the last one from each chat,
+		// instead of making the user wait for each one of them to hide.
+		const auto i = ranges::find_if(_queuedNotifications, [&](
+				const QueuedNotification &already) {
+			return (already.history == queued.history) && plain(already);
+		});
+		if (i != end(_queuedNotifications)) {
+			*i = std::move(queued);
+			return;
+		}
+	}
+	_queuedNotifications.push_back(std::move(queued));
 	showNextFromQueue();
 }
 